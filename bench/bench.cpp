@@ -0,0 +1,270 @@
+/*
+ * bench.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include <src/dlx_solver.h>
+#include <src/fixed_solver.h>
+#include <src/grid.h>
+#include <src/puzzle_reader.h>
+#include <src/sat_solver.h>
+#include <src/solver.h>
+
+#ifndef SUDOKU_BENCH_CORPUS_DIR
+#define SUDOKU_BENCH_CORPUS_DIR "bench/corpora"
+#endif
+
+using std::string;
+using std::vector;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using sudoku::DlxSolver;
+using sudoku::FixedSolver;
+using sudoku::Grid;
+using sudoku::PuzzleReader;
+using sudoku::SatSolver;
+using sudoku::SolveLimits;
+using sudoku::SolveStatus;
+using sudoku::Solver;
+using sudoku::ValueSortType;
+using sudoku::VariableSortType;
+
+struct Corpus {
+  const char* name;
+  const char* file;
+  int subrows, subcols;
+};
+
+const Corpus kCorpora[] = {
+  {"easy", "easy.txt", 3, 3},
+  {"17clue", "17clue.txt", 3, 3},
+  {"hardest", "hardest.txt", 3, 3},
+  {"generated_4x4", "generated_4x4.txt", 4, 4},
+  {"generated_5x5", "generated_5x5.txt", 5, 5},
+};
+
+enum class Engine {
+  BACKTRACK, FIXED, DLX, SAT
+};
+
+struct Config {
+  string name;
+  Engine engine;
+  VariableSortType varSortType;
+  ValueSortType valSortType;
+};
+
+vector<Config> makeConfigs() {
+  const struct {
+    const char* name;
+    VariableSortType type;
+  } varSortTypes[] = {
+    {"none", VariableSortType::NONE},
+    {"randomized", VariableSortType::RANDOMIZED},
+    {"most_constrained", VariableSortType::MOST_CONSTRAINED},
+  };
+  const struct {
+    const char* name;
+    ValueSortType type;
+  } valSortTypes[] = {
+    {"none", ValueSortType::NONE},
+    {"randomized", ValueSortType::RANDOMIZED},
+    {"least_constraining", ValueSortType::LEAST_CONSTRAINING},
+  };
+
+  vector<Config> configs;
+  for (auto& var : varSortTypes) {
+    for (auto& val : valSortTypes) {
+      configs.push_back({string("backtrack/") + var.name + "/" + val.name,
+          Engine::BACKTRACK, var.type, val.type});
+    }
+  }
+  configs.push_back({"fixed", Engine::FIXED, VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING});
+  configs.push_back({"dlx", Engine::DLX, VariableSortType::NONE,
+      ValueSortType::NONE});
+  configs.push_back({"sat", Engine::SAT, VariableSortType::NONE,
+      ValueSortType::NONE});
+  return configs;
+}
+
+bool readCorpus(const string& path, const Corpus& corpus, vector<Grid>& grids) {
+  PuzzleReader reader;
+  if (!reader.open(path.c_str()))
+    return false;
+  const int side = corpus.subrows * corpus.subcols;
+  vector<int> values;
+  while (reader.read(values, side * side) == side * side)
+    grids.emplace_back(corpus.subrows, corpus.subcols, values);
+  return true;
+}
+
+// Search steps the backtracking configs may take per puzzle by default.
+// Without a limit, the poorly ordered configs take minutes on single 17-clue
+// and 5x5 puzzles.
+const long long kDefaultMaxNodes = 200000;
+
+// Returns false if the engine doesn't support the grid's dimensions. Only
+// the backtracking configs stop at maxNodes steps (0 for no limit), which
+// sets aborted.
+bool solveGrid(const Grid& grid, const Config& config, long long maxNodes,
+    Grid& solution, int& steps, bool& solved, bool& aborted) {
+  switch (config.engine) {
+  case Engine::FIXED:
+    if (grid.getSubrows() == 3 && grid.getSubcols() == 3)
+      solved = FixedSolver<3, 3>(grid).solve(solution, steps);
+    else if (grid.getSubrows() == 4 && grid.getSubcols() == 4)
+      solved = FixedSolver<4, 4>(grid).solve(solution, steps);
+    else if (grid.getSubrows() == 5 && grid.getSubcols() == 5)
+      solved = FixedSolver<5, 5>(grid).solve(solution, steps);
+    else
+      return false;
+    return true;
+  case Engine::DLX:
+    solved = DlxSolver(grid).solve(solution, steps);
+    return true;
+  case Engine::SAT:
+    solved = SatSolver(grid).solve(solution, steps);
+    return true;
+  default: {
+    Solver solver(grid, config.varSortType, config.valSortType);
+    SolveLimits limits;
+    limits.maxNodes = maxNodes;
+    solver.setLimits(limits);
+    solved = solver.solve(solution, steps);
+    aborted = solver.getStatus() == SolveStatus::ABORTED;
+    return true;
+  }
+  }
+}
+
+// Nearest-rank percentile of sorted values.
+double percentile(const vector<double>& sorted, double p) {
+  if (sorted.empty())
+    return 0;
+  size_t rank = std::max<size_t>(1, (size_t) (p * sorted.size() + 0.999999));
+  return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+// The process's peak resident memory, which only grows, so for each config
+// it is the peak over every config run so far.
+long getPeakRssKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+void printUsage() {
+  printf("Usage: sudoku_bench [--corpora DIR] [--repeat N] [--filter TEXT]\n");
+  printf("                    [--max-nodes N]\n");
+  printf("  --corpora DIR  directory with the puzzle corpora\n");
+  printf("  --repeat N     solve each puzzle N times (default 1)\n");
+  printf("  --filter TEXT  only run corpus/config names containing TEXT\n");
+  printf("  --max-nodes N  abort backtracking solves after N steps (default\n");
+  printf("                 %lld, 0 for no limit)\n", kDefaultMaxNodes);
+  printf("Prints one JSON object per corpus and config.\n");
+}
+
+// Main method
+// Args: [--corpora DIR] [--repeat N] [--filter TEXT] [--max-nodes N]
+int main(int argc, char **argv) {
+  string corpusDir = SUDOKU_BENCH_CORPUS_DIR;
+  int repeat = 1;
+  string filter;
+  long long maxNodes = kDefaultMaxNodes;
+
+  for (int i = 1; i < argc; ++i) {
+    if (!strcmp(argv[i], "--corpora") && i + 1 < argc) {
+      corpusDir = argv[++i];
+    } else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+      repeat = atoi(argv[++i]);
+      if (repeat <= 0) {
+        fprintf(stderr, "Error: Illegal repeat count (should be an integer >0).\n");
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (!strcmp(argv[i], "--max-nodes") && i + 1 < argc) {
+      maxNodes = atoll(argv[++i]);
+      if (maxNodes < 0) {
+        fprintf(stderr, "Error: Illegal node limit (should be an integer >=0).\n");
+        exit(1);
+      }
+    } else {
+      printUsage();
+      exit(strcmp(argv[i], "--help") ? 1 : 0);
+    }
+  }
+
+  const vector<Config> configs = makeConfigs();
+  for (auto& corpus : kCorpora) {
+    vector<Grid> grids;
+    if (!readCorpus(corpusDir + "/" + corpus.file, corpus, grids)) {
+      fprintf(stderr, "Error: Could not open %s/%s.\n", corpusDir.c_str(),
+          corpus.file);
+      exit(1);
+    }
+
+    for (auto& config : configs) {
+      const string name = string(corpus.name) + "/" + config.name;
+      if (name.find(filter) == string::npos)
+        continue;
+
+      vector<double> latencies;
+      long long nodes = 0;
+      int solved = 0, aborted = 0;
+      bool supported = true;
+      for (int r = 0; r < repeat && supported; ++r) {
+        for (auto& grid : grids) {
+          Grid solution;
+          int steps = 0;
+          bool isSolved = false, isAborted = false;
+          auto begin = steady_clock::now();
+          supported = solveGrid(grid, config, maxNodes, solution, steps,
+              isSolved, isAborted);
+          auto end = steady_clock::now();
+          if (!supported)
+            break;
+          latencies.push_back(duration_cast<nanoseconds>(end - begin).count()
+              / 1000.0);
+          nodes += steps;
+          solved += isSolved;
+          aborted += isAborted;
+        }
+      }
+      if (!supported)
+        continue;
+
+      double seconds = 0;
+      for (auto& latency : latencies)
+        seconds += latency / 1000000.0;
+      std::sort(latencies.begin(), latencies.end());
+      printf("{\"corpus\": \"%s\", \"config\": \"%s\", \"puzzles\": %d, "
+          "\"solved\": %d, \"aborted\": %d, \"nodes\": %lld, "
+          "\"seconds\": %.6f, \"puzzles_per_sec\": %.1f, "
+          "\"nodes_per_sec\": %.1f, \"median_us\": %.1f, \"p99_us\": %.1f, "
+          "\"cumulative_peak_rss_kb\": %ld}\n",
+          corpus.name, config.name.c_str(), (int) latencies.size(), solved,
+          aborted, nodes, seconds, seconds > 0 ? latencies.size() / seconds : 0,
+          seconds > 0 ? nodes / seconds : 0, percentile(latencies, 0.5),
+          percentile(latencies, 0.99), getPeakRssKb());
+      fflush(stdout);
+    }
+  }
+
+  exit(0);
+}
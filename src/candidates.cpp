@@ -0,0 +1,147 @@
+/*
+ * candidates.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+
+#include <src/candidates.h>
+
+namespace sudoku {
+
+Candidates::Candidates():
+    maxValue_(0), numWords_(1), word_(0) {
+}
+
+Candidates::Candidates(int maxValue):
+    maxValue_(maxValue), numWords_(1), word_(0) {
+  if (maxValue_ > kWordBits) {
+    numWords_ = (maxValue_ + kWordBits - 1) / kWordBits;
+    words_.reset(new Word[numWords_]());
+  }
+}
+
+Candidates::Candidates(const Candidates& other):
+    maxValue_(other.maxValue_), numWords_(other.numWords_),
+    word_(other.word_) {
+  if (numWords_ > 1) {
+    words_.reset(new Word[numWords_]);
+    std::copy(other.words_.get(), other.words_.get() + numWords_,
+        words_.get());
+  }
+}
+
+Candidates::Candidates(Candidates&& other) noexcept:
+    maxValue_(other.maxValue_), numWords_(other.numWords_),
+    word_(other.word_), words_(std::move(other.words_)) {
+  other.maxValue_ = 0;
+  other.numWords_ = 1;
+  other.word_ = 0;
+}
+
+Candidates& Candidates::operator =(const Candidates& other) {
+  if (this == &other)
+    return *this;
+  if (other.numWords_ > 1 && (numWords_ != other.numWords_ || !words_))
+    words_.reset(new Word[other.numWords_]);
+  maxValue_ = other.maxValue_;
+  numWords_ = other.numWords_;
+  word_ = other.word_;
+  if (numWords_ > 1) {
+    std::copy(other.words_.get(), other.words_.get() + numWords_,
+        words_.get());
+  }
+  return *this;
+}
+
+Candidates& Candidates::operator =(Candidates&& other) noexcept {
+  if (this == &other)
+    return *this;
+  maxValue_ = other.maxValue_;
+  numWords_ = other.numWords_;
+  word_ = other.word_;
+  words_ = std::move(other.words_);
+  other.maxValue_ = 0;
+  other.numWords_ = 1;
+  other.word_ = 0;
+  return *this;
+}
+
+void Candidates::clear() {
+  std::fill(data(), data() + numWords_, Word(0));
+}
+
+void Candidates::fill() {
+  Word* words = data();
+  std::fill(words, words + numWords_, ~Word(0));
+  const int tail = maxValue_ % kWordBits;
+  if (tail)
+    words[numWords_ - 1] = (Word(1) << tail) - 1;
+  if (maxValue_ == 0)
+    words[0] = 0;
+}
+
+void Candidates::setOnly(int value) {
+  clear();
+  emplace(value);
+}
+
+Candidates& Candidates::operator &=(const Candidates& other) {
+  Word* words = data();
+  const Word* others = other.data();
+  const int n = std::min(numWords_, other.numWords_);
+  for (int i = 0; i < n; ++i)
+    words[i] &= others[i];
+  std::fill(words + n, words + numWords_, Word(0));
+  return *this;
+}
+
+Candidates& Candidates::operator |=(const Candidates& other) {
+  Word* words = data();
+  const Word* others = other.data();
+  const int n = std::min(numWords_, other.numWords_);
+  for (int i = 0; i < n; ++i)
+    words[i] |= others[i];
+  return *this;
+}
+
+Candidates& Candidates::removeAll(const Candidates& other) {
+  Word* words = data();
+  const Word* others = other.data();
+  const int n = std::min(numWords_, other.numWords_);
+  for (int i = 0; i < n; ++i)
+    words[i] &= ~others[i];
+  return *this;
+}
+
+bool Candidates::intersects(const Candidates& other) const {
+  const Word* words = data();
+  const Word* others = other.data();
+  const int n = std::min(numWords_, other.numWords_);
+  for (int i = 0; i < n; ++i) {
+    if (words[i] & others[i])
+      return true;
+  }
+  return false;
+}
+
+bool Candidates::isSubsetOf(const Candidates& other) const {
+  const Word* words = data();
+  const Word* others = other.data();
+  for (int i = 0; i < numWords_; ++i) {
+    const Word otherWord = i < other.numWords_ ? others[i] : 0;
+    if (words[i] & ~otherWord)
+      return false;
+  }
+  return true;
+}
+
+bool Candidates::operator ==(const Candidates& other) const {
+  if (maxValue_ != other.maxValue_)
+    return false;
+  return std::equal(data(), data() + numWords_, other.data());
+}
+
+} /* namespace sudoku */
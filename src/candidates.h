@@ -0,0 +1,212 @@
+/*
+ * candidates.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef CANDIDATES_H_
+#define CANDIDATES_H_
+
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace sudoku {
+
+// Set of candidate values 1..maxValue stored as a bit mask (value v is bit
+// v - 1). Masks of up to 64 values live in a single inline word; larger ones
+// use a heap-allocated array of words.
+class Candidates {
+public:
+  typedef uint64_t Word;
+  static const int kWordBits = 64;
+
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef int reference;
+
+    const_iterator(): words_(nullptr), numWords_(0), word_(0), bits_(0) {}
+    const_iterator(const Word* words, int numWords);
+
+    int operator *() const { return word_ * kWordBits + lowestBit(bits_) + 1; }
+    const_iterator& operator ++();
+    const_iterator operator ++(int);
+    bool operator ==(const const_iterator& other) const;
+    bool operator !=(const const_iterator& other) const { return !(*this == other); }
+
+  private:
+    const Word* words_;
+    int numWords_;
+    int word_;
+    Word bits_;
+
+    void skipEmpty();
+  };
+
+  Candidates();
+  explicit Candidates(int maxValue);
+  Candidates(const Candidates& other);
+  Candidates(Candidates&& other) noexcept;
+  Candidates& operator =(const Candidates& other);
+  Candidates& operator =(Candidates&& other) noexcept;
+
+  int getMaxValue() const { return maxValue_; }
+  int getNumWords() const { return numWords_; }
+  const Word* data() const { return numWords_ == 1 ? &word_ : words_.get(); }
+  Word* data() { return numWords_ == 1 ? &word_ : words_.get(); }
+
+  int size() const;
+  bool empty() const;
+  int count(int value) const;
+  int front() const;
+
+  const_iterator begin() const { return const_iterator(data(), numWords_); }
+  const_iterator end() const { return const_iterator(); }
+
+  bool emplace(int value);
+  int erase(int value);
+  void clear();
+  void fill();
+  void setOnly(int value);
+
+  Candidates& operator &=(const Candidates& other);
+  Candidates& operator |=(const Candidates& other);
+  Candidates& removeAll(const Candidates& other);
+  bool intersects(const Candidates& other) const;
+  bool isSubsetOf(const Candidates& other) const;
+
+  bool operator ==(const Candidates& other) const;
+  bool operator !=(const Candidates& other) const { return !(*this == other); }
+
+  static int popcount(Word word);
+  static int lowestBit(Word word);
+
+private:
+  int maxValue_;
+  int numWords_;
+  Word word_;
+  std::unique_ptr<Word[]> words_;
+
+  bool inRange(int value) const { return 1 <= value && value <= maxValue_; }
+};
+
+inline int Candidates::popcount(Word word) {
+#if defined(__GNUC__)
+  return __builtin_popcountll(word);
+#else
+  int n = 0;
+  for (; word; word &= word - 1)
+    ++n;
+  return n;
+#endif
+}
+
+inline int Candidates::lowestBit(Word word) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(word);
+#else
+  int n = 0;
+  for (; !(word & 1); word >>= 1)
+    ++n;
+  return n;
+#endif
+}
+
+inline int Candidates::size() const {
+  if (numWords_ == 1)
+    return popcount(word_);
+  int n = 0;
+  for (int i = 0; i < numWords_; ++i)
+    n += popcount(words_[i]);
+  return n;
+}
+
+inline bool Candidates::empty() const {
+  if (numWords_ == 1)
+    return word_ == 0;
+  for (int i = 0; i < numWords_; ++i) {
+    if (words_[i])
+      return false;
+  }
+  return true;
+}
+
+inline int Candidates::count(int value) const {
+  if (!inRange(value))
+    return 0;
+  const int bit = value - 1;
+  return (data()[bit / kWordBits] >> (bit % kWordBits)) & 1;
+}
+
+inline int Candidates::front() const {
+  const Word* words = data();
+  for (int i = 0; i < numWords_; ++i) {
+    if (words[i])
+      return i * kWordBits + lowestBit(words[i]) + 1;
+  }
+  return 0;
+}
+
+inline bool Candidates::emplace(int value) {
+  if (!inRange(value))
+    return false;
+  const int bit = value - 1;
+  Word& word = data()[bit / kWordBits];
+  const Word mask = Word(1) << (bit % kWordBits);
+  const bool inserted = !(word & mask);
+  word |= mask;
+  return inserted;
+}
+
+inline int Candidates::erase(int value) {
+  if (!inRange(value))
+    return 0;
+  const int bit = value - 1;
+  Word& word = data()[bit / kWordBits];
+  const Word mask = Word(1) << (bit % kWordBits);
+  if (!(word & mask))
+    return 0;
+  word &= ~mask;
+  return 1;
+}
+
+inline Candidates::const_iterator::const_iterator(const Word* words,
+    int numWords): words_(words), numWords_(numWords), word_(0),
+    bits_(numWords > 0 ? words[0] : 0) {
+  skipEmpty();
+}
+
+inline void Candidates::const_iterator::skipEmpty() {
+  while (!bits_ && ++word_ < numWords_)
+    bits_ = words_[word_];
+  if (!bits_)
+    *this = const_iterator();
+}
+
+inline Candidates::const_iterator& Candidates::const_iterator::operator ++() {
+  bits_ &= bits_ - 1;
+  skipEmpty();
+  return *this;
+}
+
+inline Candidates::const_iterator Candidates::const_iterator::operator ++(int) {
+  const_iterator old(*this);
+  ++*this;
+  return old;
+}
+
+inline bool Candidates::const_iterator::operator ==(
+    const const_iterator& other) const {
+  return bits_ == other.bits_ && word_ == other.word_
+      && words_ == other.words_;
+}
+
+} /* namespace sudoku */
+
+#endif /* CANDIDATES_H_ */
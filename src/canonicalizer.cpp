@@ -0,0 +1,274 @@
+/*
+ * canonicalizer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <src/canonicalizer.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+double factorial(int n) {
+  double result = 1;
+  for (int i = 2; i <= n; ++i)
+    result *= i;
+  return result;
+}
+
+vector<int> transpose(const vector<int>& values, int side) {
+  vector<int> transposed(values.size());
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col)
+      transposed[col * side + row] = values[row * side + col];
+  }
+  return transposed;
+}
+
+} /* namespace */
+
+const int Canonicalizer::kMaxColumnOrders;
+
+vector<int> GridTransform::apply(const vector<int>& values) const {
+  vector<int> result(side * side);
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      const int index = transposed ? cols[col] * side + rows[row]
+          : rows[row] * side + cols[col];
+      result[row * side + col] = labels[values[index]];
+    }
+  }
+  return result;
+}
+
+vector<int> GridTransform::invert(const vector<int>& values) const {
+  vector<int> sources(labels.size());
+  for (int value = 0; value < (signed) labels.size(); ++value)
+    sources[labels[value]] = value;
+  vector<int> result(side * side);
+  for (int row = 0; row < side; ++row) {
+    for (int col = 0; col < side; ++col) {
+      const int index = transposed ? cols[col] * side + rows[row]
+          : rows[row] * side + cols[col];
+      result[index] = sources[values[row * side + col]];
+    }
+  }
+  return result;
+}
+
+Canonicalizer::Canonicalizer(int subrows, int subcols):
+    subrows_(subrows), subcols_(subcols), side_(subrows * subcols),
+    transposed_(false) {
+  // There are subrows stacks of subcols columns.
+  const double numStackOrders = factorial(subrows_);
+  reorderLines_ = numStackOrders * std::pow(factorial(subcols_), subrows_)
+      <= kMaxColumnOrders;
+  reorderBoxes_ = numStackOrders <= kMaxColumnOrders;
+
+  cols_.resize(side_);
+  rows_.resize(side_);
+  stacks_.resize(subrows_);
+  bands_.resize(subcols_);
+  usedCols_.assign(side_, 0);
+  usedRows_.assign(side_, 0);
+  usedStacks_.assign(subrows_, 0);
+  usedBands_.assign(subcols_, 0);
+  firstRows_.resize(side_ + 1);
+  labels_.assign((side_ + 1) * (side_ + 1), 0);
+  numLabels_.assign(side_ + 1, 0);
+}
+
+string Canonicalizer::canonicalize(const vector<int>& values,
+    GridTransform& transform) {
+  vector<int> given(side_ * side_);
+  for (int i = 0; i < (signed) given.size() && i < (signed) values.size();
+      ++i) {
+    if (0 < values[i] && values[i] <= side_)
+      given[i] = values[i];
+  }
+
+  best_.clear();
+  image_.assign(side_ * side_, '0');
+  findFirstRow(given);
+  for (int t = 0; t < (subrows_ == subcols_ ? 2 : 1); ++t) {
+    transposed_ = t;
+    grid_ = transposed_ ? transpose(given, side_) : given;
+    firstRows_[0].clear();
+    for (int row = 0; row < side_; ++row) {
+      if (canBeFirst(row))
+        firstRows_[0].push_back(row);
+    }
+    searchColumns(0);
+  }
+  transform = bestTransform_;
+  return best_;
+}
+
+string Canonicalizer::canonicalize(const Grid& grid,
+    GridTransform& transform) {
+  vector<int> values(grid.size());
+  for (int i = 0; i < grid.size(); ++i)
+    values[i] = grid.getValues(i).size() == 1 ? grid.getValues(i).front() : 0;
+  return canonicalize(values, transform);
+}
+
+// The canonical form starts with the smallest first row of any image. Its
+// givens are labeled 1, 2, ... in order, so only which of its cells are
+// given matters: as few as possible, as late as possible. A row's best
+// pattern puts each stack's blanks first, then the stacks in order.
+void Canonicalizer::findFirstRow(const vector<int>& values) {
+  firstRow_.clear();
+  vector<vector<char>> stacks(subrows_);
+  vector<char> pattern;
+  for (int t = 0; t < (subrows_ == subcols_ ? 2 : 1); ++t) {
+    const vector<int> grid = t ? transpose(values, side_) : values;
+    for (int row = 0; row < side_; ++row) {
+      if (!canBeFirst(row))
+        continue;
+      for (int stack = 0; stack < subrows_; ++stack) {
+        stacks[stack].resize(subcols_);
+        for (int i = 0; i < subcols_; ++i)
+          stacks[stack][i] = grid[row * side_ + stack * subcols_ + i] != 0;
+        if (reorderLines_)
+          std::sort(stacks[stack].begin(), stacks[stack].end());
+      }
+      if (reorderBoxes_)
+        std::sort(stacks.begin(), stacks.end());
+      pattern.clear();
+      for (auto& stack : stacks)
+        pattern.insert(pattern.end(), stack.begin(), stack.end());
+      if (firstRow_.empty() || pattern < firstRow_)
+        firstRow_ = pattern;
+    }
+  }
+}
+
+bool Canonicalizer::canBeFirst(int row) const {
+  return (reorderLines_ || row % subrows_ == 0)
+      && (reorderBoxes_ || row < subrows_);
+}
+
+// Fixes the source of column col, given those before it.
+void Canonicalizer::searchColumns(int col) {
+  if (col == side_) {
+    searchRows(0);
+    return;
+  }
+  const int offset = col % subcols_;
+  if (offset == 0) {
+    for (int stack = 0; stack < subrows_; ++stack) {
+      if (usedStacks_[stack] || (!reorderBoxes_ && stack != col / subcols_))
+        continue;
+      usedStacks_[stack] = 1;
+      stacks_[col / subcols_] = stack;
+      for (int i = 0; i < subcols_; ++i) {
+        if (reorderLines_ || i == offset)
+          tryColumn(col, stack * subcols_ + i);
+      }
+      usedStacks_[stack] = 0;
+    }
+    return;
+  }
+  const int stack = stacks_[col / subcols_];
+  for (int i = 0; i < subcols_; ++i) {
+    const int source = stack * subcols_ + i;
+    if (!usedCols_[source] && (reorderLines_ || i == offset))
+      tryColumn(col, source);
+  }
+}
+
+void Canonicalizer::tryColumn(int col, int source) {
+  vector<int>& rows = firstRows_[col + 1];
+  rows.clear();
+  for (auto row : firstRows_[col]) {
+    if ((grid_[row * side_ + source] != 0) == firstRow_[col])
+      rows.push_back(row);
+  }
+  if (rows.empty())
+    return;
+  usedCols_[source] = 1;
+  cols_[col] = source;
+  searchColumns(col + 1);
+  usedCols_[source] = 0;
+}
+
+// Fixes the source of row, given the columns and the rows before it.
+void Canonicalizer::searchRows(int row) {
+  const int offset = row % subrows_;
+  if (offset == 0) {
+    for (int band = 0; band < subcols_; ++band) {
+      if (usedBands_[band] || (!reorderBoxes_ && band != row / subrows_))
+        continue;
+      usedBands_[band] = 1;
+      bands_[row / subrows_] = band;
+      for (int i = 0; i < subrows_; ++i) {
+        if (reorderLines_ || i == offset)
+          tryRow(row, band * subrows_ + i);
+      }
+      usedBands_[band] = 0;
+    }
+    return;
+  }
+  const int band = bands_[row / subrows_];
+  for (int i = 0; i < subrows_; ++i) {
+    const int source = band * subrows_ + i;
+    if (!usedRows_[source] && (reorderLines_ || i == offset))
+      tryRow(row, source);
+  }
+}
+
+void Canonicalizer::tryRow(int row, int source) {
+  if (row == 0) {
+    const vector<int>& firstRows = firstRows_[side_];
+    if (std::find(firstRows.begin(), firstRows.end(), source)
+        == firstRows.end())
+      return;
+  }
+
+  // Values are labeled in order of first appearance.
+  int* const labels = &labels_[(row + 1) * (side_ + 1)];
+  std::copy(&labels_[row * (side_ + 1)], labels, labels);
+  int numLabels = numLabels_[row];
+  char* const image = &image_[row * side_];
+  for (int col = 0; col < side_; ++col) {
+    const int value = grid_[source * side_ + cols_[col]];
+    if (value && !labels[value])
+      labels[value] = ++numLabels;
+    image[col] = '0' + labels[value];
+  }
+  numLabels_[row + 1] = numLabels;
+
+  const int order = best_.empty() ? -1
+      : memcmp(image_.data(), best_.data(), (row + 1) * side_);
+  if (order > 0)
+    return;
+  usedRows_[source] = 1;
+  rows_[row] = source;
+  if (row + 1 < side_) {
+    searchRows(row + 1);
+  } else if (order < 0) {
+    best_ = image_;
+    bestTransform_.side = side_;
+    bestTransform_.transposed = transposed_;
+    bestTransform_.rows = rows_;
+    bestTransform_.cols = cols_;
+    // Values that aren't given take the remaining labels.
+    bestTransform_.labels.assign(labels, labels + side_ + 1);
+    for (int value = 1; value <= side_; ++value) {
+      if (!bestTransform_.labels[value])
+        bestTransform_.labels[value] = ++numLabels;
+    }
+  }
+  usedRows_[source] = 0;
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,98 @@
+/*
+ * canonicalizer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef CANONICALIZER_H_
+#define CANONICALIZER_H_
+
+#include <string>
+#include <vector>
+
+#include <src/grid.h>
+
+namespace sudoku {
+
+// A symmetry of a grid: an optional transposition, then a reordering of the
+// rows and columns, then a relabeling of the values.
+struct GridTransform {
+  int side = 0;
+  bool transposed = false;
+  // Source row (after transposing) of each transformed row, and likewise
+  // for columns.
+  std::vector<int> rows, cols;
+  // Transformed value of each value; labels[0] is 0, for blanks.
+  std::vector<int> labels;
+
+  // Transforms values (0 for blanks) in row-major order.
+  std::vector<int> apply(const std::vector<int>& values) const;
+  // Undoes apply.
+  std::vector<int> invert(const std::vector<int>& values) const;
+};
+
+// Maps grids to a canonical form shared by all grids that are equivalent
+// under the symmetries that keep puzzles valid: relabeling values,
+// reordering rows within a band or columns within a stack, reordering bands
+// or stacks, and transposing when subrows == subcols. The form is the
+// lexicographically smallest (blanks first) of the grid's images, as one
+// character per cell, '0' plus its value.
+//
+// The search fixes the columns first, pruned to orders in which some row
+// can still be the smallest possible first row, then fixes rows one at a
+// time, pruning orders whose rows so far already exceed the best image.
+// Grids with more than kMaxColumnOrders column orders (16x16 ones, for
+// instance) only reorder whole bands and stacks, or, when even those are
+// too many, are only relabeled and transposed; equivalent grids then don't
+// always share a form.
+class Canonicalizer {
+public:
+  Canonicalizer(int subrows, int subcols);
+
+  // Whether rows and columns are reordered within bands and stacks, and
+  // whether bands and stacks are reordered.
+  bool isReorderingLines() const { return reorderLines_; }
+  bool isReorderingBoxes() const { return reorderBoxes_; }
+
+  // Values are in row-major order, with 0 for blanks.
+  std::string canonicalize(const std::vector<int>& values,
+      GridTransform& transform);
+  // Cells with a single candidate count as given.
+  std::string canonicalize(const Grid& grid, GridTransform& transform);
+
+  static const int kMaxColumnOrders = 5000;
+
+private:
+  int subrows_, subcols_, side_;
+  bool reorderLines_, reorderBoxes_;
+
+  // Grid being searched (transposed or not), and the smallest first row
+  // pattern: for each column, whether the cell is given.
+  std::vector<int> grid_;
+  bool transposed_;
+  std::vector<char> firstRow_;
+
+  std::vector<int> cols_, rows_;
+  std::vector<int> stacks_, bands_;
+  std::vector<char> usedCols_, usedRows_, usedStacks_, usedBands_;
+  // Rows that can still be first, for each number of columns fixed.
+  std::vector<std::vector<int>> firstRows_;
+  // Labels given so far, for each number of rows fixed.
+  std::vector<int> labels_;
+  std::vector<int> numLabels_;
+
+  std::string image_, best_;
+  GridTransform bestTransform_;
+
+  void findFirstRow(const std::vector<int>& values);
+  bool canBeFirst(int row) const;
+  void searchColumns(int col);
+  void tryColumn(int col, int source);
+  void searchRows(int row);
+  void tryRow(int row, int source);
+};
+
+} /* namespace sudoku */
+
+#endif /* CANONICALIZER_H_ */
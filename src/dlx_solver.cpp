@@ -0,0 +1,171 @@
+/*
+ * dlx_solver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <src/dlx_solver.h>
+
+using std::vector;
+
+namespace sudoku {
+
+DlxSolver::DlxSolver(Grid grid):
+    grid_(grid), status_(SolveStatus::UNSOLVABLE) {
+}
+
+bool DlxSolver::solve(Grid& solution, int& steps) {
+  steps = 0;
+  build();
+  chosen_.clear();
+  limitCheck_.start(limits_);
+  if (!search(steps)) {
+    status_ = limitCheck_.isAborted() ? SolveStatus::ABORTED
+        : SolveStatus::UNSOLVABLE;
+    return false;
+  }
+  status_ = SolveStatus::SOLVED;
+
+  solution = grid_;
+  for (auto& row : chosen_)
+    solution[rowIndices_[row]].setOnly(rowValues_[row]);
+  solution.clearTrail();
+  return true;
+}
+
+void DlxSolver::build() {
+  const int side = grid_.getNumRows();
+  const int numColumns = 4 * grid_.size();
+
+  left_.clear();
+  right_.clear();
+  up_.clear();
+  down_.clear();
+  column_.clear();
+  row_.clear();
+  rowIndices_.clear();
+  rowValues_.clear();
+  sizes_.assign(numColumns + 1, 0);
+
+  for (int i = 0; i <= numColumns; ++i) {
+    left_.push_back(i == 0 ? numColumns : i - 1);
+    right_.push_back(i == numColumns ? 0 : i + 1);
+    up_.push_back(i);
+    down_.push_back(i);
+    column_.push_back(i);
+    row_.push_back(-1);
+  }
+
+  for (int i = 0; i < grid_.size(); ++i) {
+    const int r = grid_.getRow(i);
+    const int c = grid_.getCol(i);
+    const int b = grid_.getBox(i);
+    for (auto value : grid_.getValues(i)) {
+      const int v = value - grid_.getMinValue();
+      const int row = rowIndices_.size();
+      rowIndices_.push_back(i);
+      rowValues_.push_back(value);
+
+      const int columns[4] = {
+          1 + i,
+          1 + grid_.size() + r * side + v,
+          1 + 2 * grid_.size() + c * side + v,
+          1 + 3 * grid_.size() + b * side + v,
+      };
+      int first = -1;
+      for (auto& column : columns) {
+        int node = addNode(column, row);
+        if (first == -1) {
+          first = node;
+          continue;
+        }
+        left_[node] = left_[first];
+        right_[node] = first;
+        right_[left_[first]] = node;
+        left_[first] = node;
+      }
+    }
+  }
+}
+
+int DlxSolver::addNode(int column, int row) {
+  const int node = column_.size();
+  left_.push_back(node);
+  right_.push_back(node);
+  up_.push_back(up_[column]);
+  down_.push_back(column);
+  column_.push_back(column);
+  row_.push_back(row);
+  down_[up_[column]] = node;
+  up_[column] = node;
+  sizes_[column]++;
+  return node;
+}
+
+void DlxSolver::cover(int column) {
+  right_[left_[column]] = right_[column];
+  left_[right_[column]] = left_[column];
+  for (int i = down_[column]; i != column; i = down_[i]) {
+    for (int j = right_[i]; j != i; j = right_[j]) {
+      down_[up_[j]] = down_[j];
+      up_[down_[j]] = up_[j];
+      sizes_[column_[j]]--;
+    }
+  }
+}
+
+void DlxSolver::uncover(int column) {
+  for (int i = up_[column]; i != column; i = up_[i]) {
+    for (int j = left_[i]; j != i; j = left_[j]) {
+      sizes_[column_[j]]++;
+      down_[up_[j]] = j;
+      up_[down_[j]] = j;
+    }
+  }
+  right_[left_[column]] = column;
+  left_[right_[column]] = column;
+}
+
+int DlxSolver::selectColumn() const {
+  int best = right_[0];
+  for (int c = right_[best]; c != 0; c = right_[c]) {
+    if (sizes_[c] < sizes_[best])
+      best = c;
+    if (sizes_[best] <= 1)
+      break;
+  }
+  return best;
+}
+
+// Returns true once a solution is chosen; an aborted search unwinds with
+// false.
+bool DlxSolver::search(int& steps) {
+  if (right_[0] == 0)
+    return true;
+
+  const int column = selectColumn();
+  if (sizes_[column] == 0)
+    return false;
+
+  cover(column);
+  for (int i = down_[column]; i != column; i = down_[i]) {
+    if (limitCheck_(steps))
+      break;
+    steps++;
+    chosen_.push_back(row_[i]);
+    for (int j = right_[i]; j != i; j = right_[j])
+      cover(column_[j]);
+
+    if (search(steps))
+      return true;
+
+    for (int j = left_[i]; j != i; j = left_[j])
+      uncover(column_[j]);
+    chosen_.pop_back();
+  }
+  uncover(column);
+  return false;
+}
+
+} /* namespace sudoku */
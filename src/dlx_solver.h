@@ -0,0 +1,58 @@
+/*
+ * dlx_solver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef DLX_SOLVER_H_
+#define DLX_SOLVER_H_
+
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Solves a grid as an exact cover problem with Knuth's Dancing Links
+// (Algorithm X). Columns are the cell, row-value, column-value and box-value
+// constraints; matrix rows are the (cell, value) candidates of the grid.
+class DlxSolver {
+public:
+  explicit DlxSolver(Grid grid);
+
+  const Grid& getGrid() const { return grid_; }
+
+  // Checked as in Solver, counting each row tried as a step. None by
+  // default.
+  const SolveLimits& getLimits() const { return limits_; }
+  void setLimits(const SolveLimits& limits) { limits_ = limits; }
+  SolveStatus getStatus() const { return status_; }
+
+  bool solve(Grid& solution, int& steps);
+
+private:
+  Grid grid_;
+  SolveLimits limits_;
+  LimitCheck limitCheck_;
+  SolveStatus status_;
+
+  // Node links of the toroidal matrix; node 0 is the root and nodes
+  // 1..numColumns are the column headers.
+  std::vector<int> left_, right_, up_, down_, column_, row_;
+  std::vector<int> sizes_;
+  std::vector<int> rowIndices_, rowValues_;
+  std::vector<int> chosen_;
+
+  void build();
+  int addNode(int column, int row);
+  void cover(int column);
+  void uncover(int column);
+  int selectColumn() const;
+  bool search(int& steps);
+};
+
+} /* namespace sudoku */
+
+#endif /* DLX_SOLVER_H_ */
@@ -0,0 +1,306 @@
+/*
+ * fixed_solver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef FIXED_SOLVER_H_
+#define FIXED_SOLVER_H_
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <src/candidates.h>
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Peer table for a SubRows x SubCols grid, generated at compile time. Each
+// cell's peers are listed in ascending index order, as in Grid.
+template <int SubRows, int SubCols>
+struct FixedPeers {
+  static constexpr int kSide = SubRows * SubCols;
+  static constexpr int kSize = kSide * kSide;
+  static constexpr int kNumPeers = 2 * (kSide - 1) + (SubRows - 1) * (SubCols - 1);
+
+  int16_t peers[kSize][kNumPeers];
+
+  // Lists each cell's peers row by row, so the table takes
+  // O(kSize * kNumPeers) steps to build rather than comparing every pair of
+  // cells (which goes past compilers' constexpr step limits for 25x25).
+  constexpr FixedPeers(): peers() {
+    for (int i = 0; i < kSize; ++i) {
+      const int row = i / kSide;
+      const int col = i % kSide;
+      const int boxCol = col / SubCols * SubCols;
+      int n = 0;
+      for (int r = 0; r < kSide; ++r) {
+        if (r == row) {
+          for (int c = 0; c < kSide; ++c) {
+            if (c != col)
+              peers[i][n++] = r * kSide + c;
+          }
+        } else if (r / SubRows == row / SubRows) {
+          for (int c = boxCol; c < boxCol + SubCols; ++c)
+            peers[i][n++] = r * kSide + c;
+        } else {
+          peers[i][n++] = r * kSide + col;
+        }
+      }
+    }
+  }
+};
+
+// Grid with dimensions fixed at compile time. Candidates are single-word
+// masks in fixed-size storage, so loops over cells and peers have constant
+// bounds.
+template <int SubRows, int SubCols>
+class FixedGrid {
+public:
+  typedef FixedPeers<SubRows, SubCols> Peers;
+  static constexpr int kSide = Peers::kSide;
+  static constexpr int kSize = Peers::kSize;
+  static constexpr int kNumPeers = Peers::kNumPeers;
+  typedef typename std::conditional<(kSide < 32), uint32_t, uint64_t>::type Mask;
+  static constexpr Mask kFull = (Mask(1) << kSide) - 1;
+
+  FixedGrid() { masks_.fill(kFull); }
+  explicit FixedGrid(const Grid& grid);
+
+  Grid toGrid() const;
+  // Writes the board into grid, reusing it if it has the same dimensions,
+  // which is much cheaper than building a new Grid.
+  void toGrid(Grid& grid) const;
+
+  Mask operator [](int index) const { return masks_[index]; }
+  static int count(Mask mask) { return Candidates::popcount(mask); }
+  static Mask bit(int value) { return Mask(1) << (value - 1); }
+
+  bool assign(int index, int value);
+
+  static const Peers& getPeers() {
+    static constexpr Peers peers {};
+    return peers;
+  }
+
+private:
+  std::array<Mask, kSize> masks_;
+
+  bool propogateFrom(int index, Mask value);
+  bool propogateTo(int index, Mask value);
+};
+
+// Backtracking search over a FixedGrid with the default Solver heuristics
+// (most constrained variable, least constraining value, naked singles
+// only). It visits the same nodes as Solver, so step counts match.
+template <int SubRows, int SubCols>
+class FixedSolver {
+public:
+  typedef FixedGrid<SubRows, SubCols> Board;
+
+  explicit FixedSolver(const Grid& grid):
+      grid_(grid), status_(SolveStatus::UNSOLVABLE) { reserve(); }
+  explicit FixedSolver(const Board& grid):
+      grid_(grid), status_(SolveStatus::UNSOLVABLE) { reserve(); }
+
+  // Checked as in Solver. None by default.
+  const SolveLimits& getLimits() const { return limits_; }
+  void setLimits(const SolveLimits& limits) { limits_ = limits; }
+  SolveStatus getStatus() const { return status_; }
+
+  bool solve(Grid& solution, int& steps);
+  bool solve(Board& solution, int& steps);
+
+private:
+  Board grid_;
+  SolveLimits limits_;
+  LimitCheck limitCheck_;
+  SolveStatus status_;
+  // Board of each depth, kept between solves. Each depth assigns a
+  // different cell, so searches can't go deeper than the number of
+  // unsolved cells.
+  std::vector<Board> stack_;
+
+  void reserve();
+  bool search(int depth, int& steps);
+  int selectIndex(const Board& grid) const;
+  int sortMoves(const Board& grid, int index, int* moves) const;
+};
+
+template <int SubRows, int SubCols>
+FixedGrid<SubRows, SubCols>::FixedGrid(const Grid& grid) {
+  for (int i = 0; i < kSize; ++i)
+    masks_[i] = static_cast<Mask>(grid.getValues(i).data()[0]);
+}
+
+template <int SubRows, int SubCols>
+Grid FixedGrid<SubRows, SubCols>::toGrid() const {
+  Grid grid(SubRows, SubCols);
+  toGrid(grid);
+  return grid;
+}
+
+template <int SubRows, int SubCols>
+void FixedGrid<SubRows, SubCols>::toGrid(Grid& grid) const {
+  if (grid.getSubrows() != SubRows || grid.getSubcols() != SubCols)
+    grid = Grid(SubRows, SubCols);
+  grid.clearTrail();
+  for (int i = 0; i < kSize; ++i)
+    grid[i].data()[0] = masks_[i];
+}
+
+template <int SubRows, int SubCols>
+bool FixedGrid<SubRows, SubCols>::assign(int index, int value) {
+  const Mask mask = bit(value);
+  if (!(masks_[index] & mask) || count(masks_[index]) == 1)
+    return false;
+  masks_[index] = mask;
+  return propogateFrom(index, mask);
+}
+
+template <int SubRows, int SubCols>
+bool FixedGrid<SubRows, SubCols>::propogateFrom(int index, Mask value) {
+  const int16_t* peers = getPeers().peers[index];
+  for (int i = 0; i < kNumPeers; ++i) {
+    if (!propogateTo(peers[i], value))
+      return false;
+  }
+  return true;
+}
+
+template <int SubRows, int SubCols>
+bool FixedGrid<SubRows, SubCols>::propogateTo(int index, Mask value) {
+  if (!(masks_[index] & value))
+    return true;
+  masks_[index] &= ~value;
+  if (!masks_[index])
+    return false;
+  if (!(masks_[index] & (masks_[index] - 1)))
+    return propogateFrom(index, masks_[index]);
+  return true;
+}
+
+template <int SubRows, int SubCols>
+void FixedSolver<SubRows, SubCols>::reserve() {
+  int numUnsolved = 0;
+  for (int i = 0; i < Board::kSize; ++i)
+    numUnsolved += Board::count(grid_[i]) != 1;
+  stack_.resize(numUnsolved + 1);
+}
+
+template <int SubRows, int SubCols>
+bool FixedSolver<SubRows, SubCols>::solve(Grid& solution, int& steps) {
+  Board board;
+  if (!solve(board, steps))
+    return false;
+  board.toGrid(solution);
+  return true;
+}
+
+template <int SubRows, int SubCols>
+bool FixedSolver<SubRows, SubCols>::solve(Board& solution, int& steps) {
+  steps = 0;
+  status_ = SolveStatus::UNSOLVABLE;
+  // Deeper boards are copied from their parent as the search goes down.
+  stack_[0] = grid_;
+  for (int i = 0; i < Board::kSize; ++i) {
+    if (!grid_[i])
+      return false;
+  }
+  limitCheck_.start(limits_);
+  if (!search(0, steps)) {
+    if (limitCheck_.isAborted())
+      status_ = SolveStatus::ABORTED;
+    return false;
+  }
+  status_ = SolveStatus::SOLVED;
+  solution = stack_[0];
+  return true;
+}
+
+// On success the solved board is left in stack_[0]. An aborted search
+// unwinds with false.
+template <int SubRows, int SubCols>
+bool FixedSolver<SubRows, SubCols>::search(int depth, int& steps) {
+  const Board& grid = stack_[depth];
+  const int index = selectIndex(grid);
+
+  if (index == -1) {
+    stack_[0] = grid;
+    return true;
+  }
+
+  std::array<int, Board::kSide> moves;
+  const int numMoves = sortMoves(grid, index, moves.data());
+
+  for (int i = 0; i < numMoves; ++i) {
+    if (limitCheck_(steps))
+      return false;
+    steps++;
+
+    Board& next = stack_[depth + 1];
+    next = grid;
+    if (next.assign(index, moves[i]) && search(depth + 1, steps))
+      return true;
+  }
+
+  return false;
+}
+
+template <int SubRows, int SubCols>
+int FixedSolver<SubRows, SubCols>::selectIndex(const Board& grid) const {
+  int minIndex = -1;
+  int minCount = Board::kSide + 1;
+  for (int i = 0; i < Board::kSize; ++i) {
+    const int count = Board::count(grid[i]);
+    if (count != 1 && count < minCount) {
+      minIndex = i;
+      minCount = count;
+    }
+  }
+  return minIndex;
+}
+
+// Mirrors Solver::sortMoves for LEAST_CONSTRAINING so the order (and so the
+// search) is the same. Boards don't keep unit counts, so the scores are
+// counted from the row, column and box directly.
+template <int SubRows, int SubCols>
+int FixedSolver<SubRows, SubCols>::sortMoves(const Board& grid, int index,
+    int* moves) const {
+  typedef typename Board::Mask Mask;
+  const Mask candidates = grid[index];
+  int numMoves = 0;
+  for (auto mask = candidates; mask; mask &= mask - 1)
+    moves[numMoves++] = Candidates::lowestBit(mask) + 1;
+
+  const int kSide = Board::kSide;
+  const int row = index / kSide;
+  const int col = index % kSide;
+  const int box = row / SubRows * SubRows * kSide + col / SubCols * SubCols;
+  int constrainings[kSide + 1] = {};
+  auto add = [&](Mask mask) {
+    for (mask &= candidates; mask; mask &= mask - 1)
+      constrainings[Candidates::lowestBit(mask) + 1]++;
+  };
+  for (int k = 0; k < kSide; ++k) {
+    add(grid[row * kSide + k]);
+    add(grid[k * kSide + col]);
+    add(grid[box + k / SubCols * kSide + k % SubCols]);
+  }
+  for (int i = 1; i < numMoves; ++i) {
+    const int move = moves[i];
+    int j = i;
+    for (; j > 0 && constrainings[move] < constrainings[moves[j - 1]]; --j)
+      moves[j] = moves[j - 1];
+    moves[j] = move;
+  }
+  return numMoves;
+}
+
+} /* namespace sudoku */
+
+#endif /* FIXED_SOLVER_H_ */
@@ -0,0 +1,154 @@
+/*
+ * generator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+
+#include <src/fixed_solver.h>
+#include <src/generator.h>
+
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+// Generator::hasOtherSolution on FixedGrids, which are cheaper to build.
+template <int SubRows, int SubCols>
+bool hasOtherFixedSolution(const vector<int>& puzzle,
+    const vector<int>& solution, const vector<int>& orbit) {
+  typedef FixedGrid<SubRows, SubCols> Board;
+  Board grid;
+  for (int i = 0; i < Board::kSize; ++i) {
+    if (puzzle[i])
+      grid.assign(i, puzzle[i]);
+  }
+  for (auto& cell : orbit) {
+    for (auto mask = grid[cell]; mask; mask &= mask - 1) {
+      const int value = Candidates::lowestBit(mask) + 1;
+      if (value == solution[cell])
+        continue;
+      Board next(grid), other;
+      int steps;
+      if (next.assign(cell, value)
+          && FixedSolver<SubRows, SubCols>(next).solve(other, steps))
+        return true;
+    }
+    grid.assign(cell, solution[cell]);
+  }
+  return false;
+}
+
+} /* namespace */
+
+Generator::Generator(int subrows, int subcols, Symmetry symmetry,
+    uint64_t seed):
+    subrows_(subrows), subcols_(subcols), side_(subrows * subcols),
+    symmetry_(symmetry), rng_(seed) {
+}
+
+vector<int> Generator::fill() {
+  // Random value orders over an empty grid reach any complete grid; the
+  // restarts keep an unlucky fill of a large grid from stalling.
+  Solver solver(Grid(subrows_, subcols_), VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::RANDOMIZED);
+  solver.setSeed(rng_());
+  solver.setRestartPolicy(RestartPolicy::LUBY, side_ * side_);
+  Grid solution;
+  int steps;
+  solver.solve(solution, steps);
+
+  vector<int> values(solution.size());
+  for (int i = 0; i < solution.size(); ++i)
+    values[i] = solution.getValues(i).front();
+  return values;
+}
+
+void Generator::generate(vector<int>& puzzle, vector<int>& solution) {
+  solution = fill();
+  puzzle = solution;
+
+  vector<int> cells(puzzle.size());
+  for (int i = 0; i < (signed) cells.size(); ++i)
+    cells[i] = i;
+  std::shuffle(cells.begin(), cells.end(), rng_);
+
+  for (auto& index : cells) {
+    if (puzzle[index] == 0)
+      continue;
+    const vector<int> orbit = getOrbit(index);
+    for (auto& cell : orbit)
+      puzzle[cell] = 0;
+    if (hasOtherSolution(puzzle, solution, orbit)) {
+      for (auto& cell : orbit)
+        puzzle[cell] = solution[cell];
+    }
+  }
+}
+
+vector<int> Generator::getOrbit(int index) const {
+  const int row = index / side_;
+  const int col = index % side_;
+  int image = index;
+  switch (symmetry_) {
+  case Symmetry::ROTATIONAL:
+    image = (side_ - 1 - row) * side_ + (side_ - 1 - col);
+    break;
+  case Symmetry::MIRROR:
+    image = row * side_ + (side_ - 1 - col);
+    break;
+  default:
+    break;
+  }
+  if (image == index)
+    return {index};
+  return {index, image};
+}
+
+bool Generator::hasUniqueSolution(const vector<int>& puzzle) const {
+  Solver solver(Grid(subrows_, subcols_, puzzle),
+      VariableSortType::MOST_CONSTRAINED, ValueSortType::NONE,
+      PropagationLevel::HIDDEN_SINGLES);
+  int steps;
+  return solver.countSolutions(steps, 2) == 1;
+}
+
+// The puzzle had solution as its only solution before the orbit's clues
+// were removed, so any other solution differs from it in the orbit. Rather
+// than counting to two solutions, this searches for one with the first
+// orbit cell changed, then with the first kept and the second changed,
+// which skips finding the known solution again. 9x9 grids are searched with
+// FixedSolver; larger grids need hidden singles, without which searches of
+// sparse grids can take minutes.
+bool Generator::hasOtherSolution(const vector<int>& puzzle,
+    const vector<int>& solution, const vector<int>& orbit) const {
+  if (subrows_ == 3 && subcols_ == 3)
+    return hasOtherFixedSolution<3, 3>(puzzle, solution, orbit);
+
+  Grid grid(subrows_, subcols_, puzzle);
+  grid.setPropagationLevel(PropagationLevel::HIDDEN_SINGLES);
+  for (auto& cell : orbit) {
+    const Candidates values(grid.getValues(cell));
+    for (auto value : values) {
+      if (value == solution[cell])
+        continue;
+      const int mark = grid.getTrailMark();
+      if (grid.assign(cell, value)) {
+        Solver solver(grid, VariableSortType::MOST_CONSTRAINED,
+            ValueSortType::NONE, PropagationLevel::HIDDEN_SINGLES);
+        Grid other;
+        int steps;
+        if (solver.solve(other, steps))
+          return true;
+      }
+      grid.rollback(mark);
+    }
+    grid.assign(cell, solution[cell]);
+  }
+  return false;
+}
+
+} /* namespace sudoku */
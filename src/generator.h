@@ -0,0 +1,61 @@
+/*
+ * generator.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef GENERATOR_H_
+#define GENERATOR_H_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Symmetry of the clue pattern of generated puzzles: clues are removed an
+// orbit (a cell and its images) at a time.
+enum class Symmetry {
+  NONE, ROTATIONAL, MIRROR
+};
+
+// Generates puzzles with a unique solution: fills a random complete grid,
+// then removes clues in random order, keeping each removal only if the grid
+// still has a single solution. The result is minimal under the symmetry:
+// no further orbit of clues can be removed. A generator is deterministic
+// for a given seed.
+class Generator {
+public:
+  Generator(int subrows, int subcols, Symmetry symmetry = Symmetry::ROTATIONAL,
+      uint64_t seed = Solver::kDefaultSeed);
+
+  int getSubrows() const { return subrows_; }
+  int getSubcols() const { return subcols_; }
+  Symmetry getSymmetry() const { return symmetry_; }
+
+  // Values of a random complete grid, in row-major order.
+  std::vector<int> fill();
+  // Values of a puzzle (0 for blanks) and of its solution.
+  void generate(std::vector<int>& puzzle, std::vector<int>& solution);
+
+  // Cells mapped to each other by the symmetry, including index itself.
+  std::vector<int> getOrbit(int index) const;
+  bool hasUniqueSolution(const std::vector<int>& puzzle) const;
+
+private:
+  int subrows_, subcols_;
+  int side_;
+  Symmetry symmetry_;
+  std::mt19937_64 rng_;
+
+  bool hasOtherSolution(const std::vector<int>& puzzle,
+      const std::vector<int>& solution, const std::vector<int>& orbit) const;
+};
+
+} /* namespace sudoku */
+
+#endif /* GENERATOR_H_ */
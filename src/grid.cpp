@@ -10,80 +10,82 @@
 #include <src/grid.h>
 
 using std::vector;
-using std::unordered_set;
 
 namespace sudoku {
 
+namespace {
+
+uint16_t toCountKey(int count) {
+  return count == 1 ? kMrvSkipKey : std::min(count, kMrvSkipKey - 1);
+}
+
+uint64_t bit(int i) {
+  return uint64_t(1) << i;
+}
+
+} /* namespace */
+
+const int Grid::kCountBucketsMinSide;
+
 Grid::Grid():
-    values_(81) {
+    values_(81, Candidates(9)), level_(PropagationLevel::NAKED_SINGLES),
+    countsStale_(false),
+    numBucketWords_(0), numSummaryWords_(0), numPropagations_(0) {
   subrows_ = 3;
   subcols_ = 3;
   side_ = 9;
-  initNeighbors();
+  initLayout();
   initValues();
 }
 
 Grid::Grid(int subrows, int subcols):
-    values_((side_ = subrows*subcols) * subrows*subcols) {
+    values_((side_ = subrows*subcols) * subrows*subcols,
+        Candidates(subrows*subcols)),
+    level_(PropagationLevel::NAKED_SINGLES), countsStale_(false),
+    numBucketWords_(0), numSummaryWords_(0), numPropagations_(0) {
   subrows_ = subrows;
   subcols_ = subcols;
-  initNeighbors();
+  initLayout();
   initValues();
 }
 
 Grid::Grid(int subrows, int subcols, const vector<int>& grid):
-    values_((side_ = subrows*subcols) * subrows*subcols) {
+    values_((side_ = subrows*subcols) * subrows*subcols,
+        Candidates(subrows*subcols)),
+    level_(PropagationLevel::NAKED_SINGLES), countsStale_(false),
+    numBucketWords_(0), numSummaryWords_(0), numPropagations_(0) {
   subrows_ = subrows;
   subcols_ = subcols;
-  initNeighbors();
+  initLayout();
   initValues();
   for (int i = 0; i < (signed) std::min(values_.size(), grid.size()); i++) {
     if (getMinValue() <= grid[i] && grid[i] <= getMaxValue())
       assign(i, grid[i]);
   }
+  clearTrail();
 }
 
 void Grid::initValues() {
-  for (unsigned int i = 0; i < values_.size(); ++i) {
-    values_[i].reserve(getMaxValue() - getMinValue() + 1);
-    for (int j = getMinValue(); j <= getMaxValue(); ++j) {
-      values_[i].emplace(j);
-    }
-  }
+  for (auto& values : values_)
+    values.fill();
+  countKeys_.resize(values_.size());
+  setCountBuckets(side_ >= kCountBucketsMinSide);
 }
 
-void Grid::initNeighbors() {
-  neighbors_ = std::make_shared<vector<vector<int>>>(side_ * side_);
-  for (int i = 0; i < size(); ++i) {
-    int row = getRow(i);
-    int col = getCol(i);
-
-    for (int j = 0; j < side_; ++j) {
-      if (col != j)
-        (*neighbors_)[i].push_back(getIndex(row, j));
-      if (row != j)
-        (*neighbors_)[i].push_back(getIndex(j, col));
-    }
-
-    const int istart = (row / subrows_) * subrows_;
-    const int jstart = (col / subcols_) * subcols_;
-    for (int j = istart; j < istart + subrows_; ++j) {
-      for (int k = jstart; k < jstart + subcols_; ++k) {
-        if (row == j || col == k)
-          continue;
-        (*neighbors_)[i].push_back(getIndex(j, k));
-      }
-    }
-
-    std::sort(begin((*neighbors_)[i]), end((*neighbors_)[i]));
-  }
+void Grid::initLayout() {
+  layout_ = GridLayout::get(subrows_, subcols_);
+  isDirty_.assign(getNumUnits(), false);
+  eliminating_ = Candidates(side_);
+  valueCells_.resize(3 * (side_ + 1));
 }
 
-unordered_set<int>& Grid::operator ()(int row, int col) {
+Candidates& Grid::operator ()(int row, int col) {
+  countsStale_ = true;
   return values_[getIndex(row, col)];
 }
 
-unordered_set<int>& Grid::operator [](int index) {
+Candidates& Grid::operator [](int index) {
+  countsStale_ = true;
   return values_[index];
 }
 
@@ -107,20 +109,142 @@ int Grid::size() const {
   return values_.size();
 }
 
-const unordered_set<int>& Grid::getValues(int row, int col) const {
+const Candidates& Grid::getValues(int row, int col) const {
   return values_[getIndex(row, col)];
 }
 
-const unordered_set<int>& Grid::getValues(int index) const {
+const Candidates& Grid::getValues(int index) const {
   return values_[index];
 }
 
-const std::vector<int>& Grid::getNeighbors(int row, int col) const {
-  return (*neighbors_)[getIndex(row, col)];
+const uint16_t* Grid::getCountKeys() const {
+  if (countsStale_)
+    rebuildCounts();
+  return countKeys_.data();
+}
+
+int Grid::getMostConstrainedIndex() const {
+  const uint16_t* keys = getCountKeys();
+  if (!hasCountBuckets())
+    return findMinKey(keys, size());
+
+  for (int count = 0; count <= side_; ++count) {
+    if (!bucketSizes_[count])
+      continue;
+    const uint64_t* summary = &bucketSummary_[count * numSummaryWords_];
+    int i = 0;
+    while (!summary[i])
+      ++i;
+    const int word = i * 64 + Candidates::lowestBit(summary[i]);
+    return word * 64
+        + Candidates::lowestBit(bucketCells_[count * numBucketWords_ + word]);
+  }
+  return -1;
+}
+
+void Grid::setCountBuckets(bool enabled) {
+  numBucketWords_ = enabled ? (size() + 63) / 64 : 0;
+  numSummaryWords_ = (numBucketWords_ + 63) / 64;
+  bucketCells_.assign((side_ + 1) * numBucketWords_, 0);
+  bucketSummary_.assign((side_ + 1) * numSummaryWords_, 0);
+  bucketSizes_.assign(enabled ? side_ + 1 : 0, 0);
+  rebuildCounts();
 }
 
-const std::vector<int>& Grid::getNeighbors(int index) const {
-  return (*neighbors_)[index];
+int Grid::getUnitCount(int unit, int value) const {
+  if (countsStale_)
+    rebuildCounts();
+  return unitCounts_[unit * (side_ + 1) + value];
+}
+
+// Updates the counts after value is added to (delta 1) or removed from
+// (delta -1) a cell's candidates.
+void Grid::updateCounts(int index, int value, int delta) {
+  if (countsStale_)
+    return;
+  updateCountKey(index);
+  const int* units = layout_->getCellUnits(index);
+  for (int i = 0; i < 3; ++i)
+    unitCounts_[units[i] * (side_ + 1) + value] += delta;
+}
+
+void Grid::updateCountKey(int index) const {
+  const uint16_t key = toCountKey(values_[index].size());
+  if (hasCountBuckets() && key != countKeys_[index]) {
+    if (countKeys_[index] != kMrvSkipKey)
+      eraseBucket(index, countKeys_[index]);
+    if (key != kMrvSkipKey)
+      insertBucket(index, key);
+  }
+  countKeys_[index] = key;
+}
+
+void Grid::rebuildCounts() const {
+  unitCounts_.assign(getNumUnits() * (side_ + 1), 0);
+  for (int unit = 0; unit < getNumUnits(); ++unit) {
+    for (auto i : getUnit(unit)) {
+      for (auto value : values_[i])
+        ++unitCounts_[unit * (side_ + 1) + value];
+    }
+  }
+
+  std::fill(bucketCells_.begin(), bucketCells_.end(), 0);
+  std::fill(bucketSummary_.begin(), bucketSummary_.end(), 0);
+  std::fill(bucketSizes_.begin(), bucketSizes_.end(), 0);
+  for (int i = 0; i < size(); ++i) {
+    countKeys_[i] = toCountKey(values_[i].size());
+    if (hasCountBuckets() && countKeys_[i] != kMrvSkipKey)
+      insertBucket(i, countKeys_[i]);
+  }
+  countsStale_ = false;
+}
+
+void Grid::insertBucket(int index, int count) const {
+  const int word = index / 64;
+  uint64_t& cells = bucketCells_[count * numBucketWords_ + word];
+  if (!cells)
+    bucketSummary_[count * numSummaryWords_ + word / 64]
+        |= bit(word % 64);
+  cells |= bit(index % 64);
+  ++bucketSizes_[count];
+}
+
+void Grid::eraseBucket(int index, int count) const {
+  const int word = index / 64;
+  uint64_t& cells = bucketCells_[count * numBucketWords_ + word];
+  cells &= ~bit(index % 64);
+  if (!cells)
+    bucketSummary_[count * numSummaryWords_ + word / 64]
+        &= ~bit(word % 64);
+  --bucketSizes_[count];
+}
+
+CellRange Grid::getNeighbors(int row, int col) const {
+  return layout_->getPeers(getIndex(row, col));
+}
+
+CellRange Grid::getNeighbors(int index) const {
+  return layout_->getPeers(index);
+}
+
+CellRange Grid::getUnit(int unit) const {
+  return layout_->getUnit(unit);
+}
+
+int Grid::getNumUnits() const {
+  return layout_->getNumUnits();
+}
+
+int Grid::getRowUnit(int index) const {
+  return getRow(index);
+}
+
+int Grid::getColUnit(int index) const {
+  return side_ + getCol(index);
+}
+
+int Grid::getBoxUnit(int index) const {
+  return 2 * side_ + getBox(index);
 }
 
 int Grid::getIndex(int row, int col) const {
@@ -135,6 +259,10 @@ int Grid::getCol(int index) const {
   return index % getNumCols();
 }
 
+int Grid::getBox(int index) const {
+  return (getRow(index) / subrows_) * subrows_ + getCol(index) / subcols_;
+}
+
 bool Grid::assign(int row, int col, int value) {
   return assign(getIndex(row, col), value);
 }
@@ -142,25 +270,244 @@ bool Grid::assign(int row, int col, int value) {
 bool Grid::assign(int index, int value) {
   if (!values_[index].count(value) || values_[index].size() == 1)
     return false;
-  values_[index] = { value };
+  if (place(index, value) && applyRules())
+    return true;
+  clearDirty();
+  return false;
+}
+
+bool Grid::propagate() {
+  if (level_ == PropagationLevel::NAKED_SINGLES)
+    return true;
+  for (int i = 0; i < getNumUnits(); ++i)
+    markDirty(i);
+  if (applyRules())
+    return true;
+  clearDirty();
+  return false;
+}
+
+void Grid::rollback(int mark) {
+  while ((signed) trail_.size() > mark) {
+    const Elimination& last = trail_.back();
+    values_[last.index].emplace(last.value);
+    updateCounts(last.index, last.value, 1);
+    trail_.pop_back();
+  }
+}
+
+void Grid::clearTrail() {
+  trail_.clear();
+}
+
+// Each candidate is eliminated at most once between rollbacks, so the trail
+// never outgrows the number of candidates, and each unit is queued at most
+// once.
+void Grid::reserve() {
+  trail_.reserve(size() * side_);
+  dirtyUnits_.reserve(getNumUnits());
+}
+
+void Grid::eliminate(int index, int value) {
+  values_[index].erase(value);
+  updateCounts(index, value, -1);
+  trail_.push_back({ index, value });
+  if (level_ != PropagationLevel::NAKED_SINGLES) {
+    const int* units = layout_->getCellUnits(index);
+    for (int i = 0; i < 3; ++i)
+      markDirty(units[i]);
+  }
+}
+
+void Grid::markDirty(int unit) {
+  if (isDirty_[unit])
+    return;
+  isDirty_[unit] = true;
+  dirtyUnits_.push_back(unit);
+}
+
+void Grid::clearDirty() {
+  for (auto& unit : dirtyUnits_)
+    isDirty_[unit] = false;
+  dirtyUnits_.clear();
+}
+
+bool Grid::place(int index, int value) {
+  if (!values_[index].count(value))
+    return false;
+  eliminating_ = values_[index];
+  for (auto other : eliminating_) {
+    if (other != value)
+      eliminate(index, other);
+  }
   return propogateFrom(index, value);
 }
 
 bool Grid::propogateFrom(int index, int value) {
-  for (auto& i : (*neighbors_)[index]) {
-    if (!propogateTo(i, value))
+#if SUDOKU_STATS
+  numPropagations_++;
+#endif
+  if (layout_->isNarrow())
+    return propogateFrom(layout_->getNarrowPeers(index),
+        layout_->getNumPeers(index), value);
+  return propogateFrom(layout_->getWidePeers(index),
+      layout_->getNumPeers(index), value);
+}
+
+template <typename Index>
+bool Grid::propogateFrom(const Index* peers, int numPeers, int value) {
+  for (int i = 0; i < numPeers; ++i) {
+    if (!propogateTo(peers[i], value))
       return false;
   }
   return true;
 }
 
 bool Grid::propogateTo(int index, int value) {
-  if (!values_[index].erase(value))
+  if (!values_[index].count(value))
     return true;
+  eliminate(index, value);
   if (values_[index].empty())
     return false;
   if (values_[index].size() == 1)
-    return propogateFrom(index, *values_[index].begin());
+    return propogateFrom(index, values_[index].front());
+  return true;
+}
+
+bool Grid::applyRules() {
+  while (!dirtyUnits_.empty()) {
+    const int unit = dirtyUnits_.back();
+    dirtyUnits_.pop_back();
+    isDirty_[unit] = false;
+
+    if (level_ >= PropagationLevel::HIDDEN_SINGLES
+        && !applyHiddenSingles(unit))
+      return false;
+    if (level_ >= PropagationLevel::LOCKED_CANDIDATES
+        && !applyLockedCandidates(unit))
+      return false;
+    if (level_ >= PropagationLevel::PAIRS
+        && !(applyNakedPairs(unit) && applyHiddenPairs(unit)))
+      return false;
+  }
+  return true;
+}
+
+// A value with only one possible cell in a unit must go in that cell.
+bool Grid::applyHiddenSingles(int unit) {
+  for (int value = getMinValue(); value <= getMaxValue(); ++value) {
+    int count = 0;
+    int last = -1;
+    for (auto i : getUnit(unit)) {
+      if (values_[i].count(value)) {
+        count++;
+        last = i;
+      }
+    }
+    if (count == 0)
+      return false;
+    if (count == 1 && values_[last].size() > 1 && !place(last, value))
+      return false;
+  }
+  return true;
+}
+
+// If a value's cells in a unit all lie in one other unit (a box within a row
+// or column, or vice versa), the value is eliminated from the rest of it.
+bool Grid::applyLockedCandidates(int unit) {
+  for (int value = getMinValue(); value <= getMaxValue(); ++value) {
+    int count = 0;
+    int common[3];
+    for (auto i : getUnit(unit)) {
+      if (!values_[i].count(value))
+        continue;
+      const int units[3] = { getRowUnit(i), getColUnit(i), getBoxUnit(i) };
+      for (int k = 0; k < 3; ++k) {
+        if (count == 0)
+          common[k] = units[k];
+        else if (common[k] != units[k])
+          common[k] = -1;
+      }
+      count++;
+    }
+    if (count < 2)
+      continue;
+
+    for (int k = 0; k < 3; ++k) {
+      if (common[k] == -1 || common[k] == unit)
+        continue;
+      for (auto i : getUnit(common[k])) {
+        const bool inUnit = getRowUnit(i) == unit || getColUnit(i) == unit
+            || getBoxUnit(i) == unit;
+        if (!inUnit && !propogateTo(i, value))
+          return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Two cells in a unit with the same two candidates take both values, so the
+// values are eliminated from the unit's other cells.
+bool Grid::applyNakedPairs(int unit) {
+  const CellRange cells = getUnit(unit);
+  for (unsigned int a = 0; a < cells.size(); ++a) {
+    if (values_[cells[a]].size() != 2)
+      continue;
+    for (unsigned int b = a + 1; b < cells.size(); ++b) {
+      if (values_[cells[b]] != values_[cells[a]])
+        continue;
+      eliminating_ = values_[cells[a]];
+      for (auto i : cells) {
+        if (i == cells[a] || i == cells[b])
+          continue;
+        for (auto value : eliminating_) {
+          if (!propogateTo(i, value))
+            return false;
+        }
+      }
+      break;
+    }
+  }
+  return true;
+}
+
+// Two values confined to the same two cells of a unit must occupy them, so
+// the cells' other candidates are eliminated.
+bool Grid::applyHiddenPairs(int unit) {
+  const CellRange cells = getUnit(unit);
+  int* const counts = valueCells_.data();
+  int* const firsts = counts + side_ + 1;
+  int* const seconds = firsts + side_ + 1;
+  std::fill(counts, counts + side_ + 1, 0);
+  for (int value = getMinValue(); value <= getMaxValue(); ++value) {
+    for (auto i : cells) {
+      if (!values_[i].count(value))
+        continue;
+      if (counts[value] == 0)
+        firsts[value] = i;
+      else if (counts[value] == 1)
+        seconds[value] = i;
+      counts[value]++;
+    }
+  }
+
+  for (int a = getMinValue(); a <= getMaxValue(); ++a) {
+    if (counts[a] != 2)
+      continue;
+    for (int b = a + 1; b <= getMaxValue(); ++b) {
+      if (counts[b] != 2 || firsts[b] != firsts[a] || seconds[b] != seconds[a])
+        continue;
+      for (auto& i : { firsts[a], seconds[a] }) {
+        eliminating_ = values_[i];
+        for (auto value : eliminating_) {
+          if (value != a && value != b && !propogateTo(i, value))
+            return false;
+        }
+      }
+      break;
+    }
+  }
   return true;
 }
 
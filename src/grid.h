@@ -8,20 +8,31 @@
 #ifndef GRID_H_
 #define GRID_H_
 
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 #include <memory>
 
+#include <src/candidates.h>
+#include <src/grid_layout.h>
+#include <src/mrv.h>
+#include <src/solve_stats.h>
+
 namespace sudoku {
 
+// Inference applied after each assignment, run to a fixpoint. Each level
+// includes the rules of the levels before it.
+enum class PropagationLevel {
+  NAKED_SINGLES, HIDDEN_SINGLES, LOCKED_CANDIDATES, PAIRS
+};
+
 class Grid {
 public:
   Grid();
   Grid(int subrows, int subcols);
   Grid(int subrows, int subcols, const std::vector<int>& grid);
 
-  std::unordered_set<int>& operator ()(int row, int col);
-  std::unordered_set<int>& operator [](int index);
+  Candidates& operator ()(int row, int col);
+  Candidates& operator [](int index);
 
   int getSubcols() const { return subcols_; }
   int getSubrows() const { return subrows_; }
@@ -32,31 +43,112 @@ public:
   int getMaxValue() const;
   int size() const;
 
-  const std::vector<std::unordered_set<int>>& getValues() const { return values_; }
-  const std::unordered_set<int>& getValues(int row, int col) const;
-  const std::unordered_set<int>& getValues(int index) const;
+  const std::vector<Candidates>& getValues() const { return values_; }
+  const Candidates& getValues(int row, int col) const;
+  const Candidates& getValues(int index) const;
+
+  // Candidate count of each cell (kMrvSkipKey for cells with one candidate),
+  // packed for findMinKey. This and the unit counts are kept up to date by
+  // assignments and rollbacks, and rebuilt after candidates are changed
+  // through operator () or [].
+  const uint16_t* getCountKeys() const;
+  // Number of cells in the unit that still allow value.
+  int getUnitCount(int unit, int value) const;
+
+  // Returns the first cell with the fewest candidates, among cells with
+  // more than one, or -1 if every cell has one. With count buckets the
+  // cells are also kept in per-count bitsets, which makes this O(side)
+  // instead of a scan of every cell, at a small cost per elimination; they
+  // are on by default for grids with at least kCountBucketsMinSide values.
+  int getMostConstrainedIndex() const;
+  bool hasCountBuckets() const { return !bucketCells_.empty(); }
+  void setCountBuckets(bool enabled);
+
+  static const int kCountBucketsMinSide = 36;
 
-  const std::vector<std::vector<int>>& getNeighbors() const { return *neighbors_; }
-  const std::vector<int>& getNeighbors(int row, int col) const;
-  const std::vector<int>& getNeighbors(int index) const;
+  const GridLayout& getLayout() const { return *layout_; }
+  CellRange getNeighbors(int row, int col) const;
+  CellRange getNeighbors(int index) const;
+
+  CellRange getUnit(int unit) const;
+  int getNumUnits() const;
+  int getRowUnit(int index) const;
+  int getColUnit(int index) const;
+  int getBoxUnit(int index) const;
 
   int getIndex(int row, int col) const;
   int getRow(int index) const;
   int getCol(int index) const;
+  int getBox(int index) const;
+
+  PropagationLevel getPropagationLevel() const { return level_; }
+  void setPropagationLevel(PropagationLevel level) { level_ = level; }
 
   bool assign(int row, int col, int value);
   bool assign(int index, int value);
+  bool propagate();
+
+  // Number of cells whose value has been propagated to their peers (zero
+  // when built without SUDOKU_STATS).
+  long long getNumPropagations() const { return numPropagations_; }
+
+  int getTrailMark() const { return trail_.size(); }
+  void rollback(int mark);
+  void clearTrail();
+  // Reserves room for the longest possible trail, after which assignments,
+  // propagation and rollbacks don't allocate. Copying a grid doesn't keep
+  // the reservation, but assigning to a grid of the same dimensions does.
+  void reserve();
 
 private:
+  struct Elimination {
+    int index;
+    int value;
+  };
+
   int subrows_, subcols_;
   int side_;
-  std::vector<std::unordered_set<int>> values_;
-  std::shared_ptr<std::vector<std::vector<int>>> neighbors_;
+  std::vector<Candidates> values_;
+  std::shared_ptr<const GridLayout> layout_;
+  std::vector<Elimination> trail_;
+  PropagationLevel level_;
+  std::vector<int> dirtyUnits_;
+  std::vector<char> isDirty_;
+  // Scratch space for the rules, kept so they don't allocate: a copy of the
+  // candidates being eliminated from a cell, and per-value counts, first
+  // cells and second cells for hidden pairs.
+  Candidates eliminating_;
+  std::vector<int> valueCells_;
+  mutable std::vector<uint16_t> countKeys_;
+  mutable bool countsStale_;
+  mutable std::vector<int> unitCounts_;
+  // For each count, a bitset of the cells with that count and a bitset of
+  // its non-zero words.
+  int numBucketWords_, numSummaryWords_;
+  mutable std::vector<uint64_t> bucketCells_, bucketSummary_;
+  mutable std::vector<int> bucketSizes_;
+  long long numPropagations_;
 
-  void initNeighbors();
+  void initLayout();
   void initValues();
+  void updateCounts(int index, int value, int delta);
+  void updateCountKey(int index) const;
+  void rebuildCounts() const;
+  void insertBucket(int index, int count) const;
+  void eraseBucket(int index, int count) const;
+  void eliminate(int index, int value);
+  void markDirty(int unit);
+  void clearDirty();
+  bool place(int index, int value);
   bool propogateFrom(int index, int value);
+  template <typename Index>
+  bool propogateFrom(const Index* peers, int numPeers, int value);
   bool propogateTo(int index, int value);
+  bool applyRules();
+  bool applyHiddenSingles(int unit);
+  bool applyLockedCandidates(int unit);
+  bool applyNakedPairs(int unit);
+  bool applyHiddenPairs(int unit);
 };
 
 } /* namespace sudoku */
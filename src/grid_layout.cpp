@@ -0,0 +1,85 @@
+/*
+ * grid_layout.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <limits>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#include <src/grid_layout.h>
+
+using std::vector;
+
+namespace sudoku {
+
+std::shared_ptr<const GridLayout> GridLayout::get(int subrows, int subcols) {
+  static std::mutex mutex;
+  static std::map<std::pair<int, int>, std::shared_ptr<const GridLayout>> cache;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& layout = cache[std::make_pair(subrows, subcols)];
+  if (!layout)
+    layout.reset(new GridLayout(subrows, subcols));
+  return layout;
+}
+
+GridLayout::GridLayout(int subrows, int subcols):
+    subrows_(subrows), subcols_(subcols), side_(subrows * subcols),
+    narrow_(size() <= std::numeric_limits<uint16_t>::max() + 1) {
+
+  vector<int32_t> peers, units(getNumUnits() * side_);
+  cellUnits_.reserve(3 * size());
+  peerOffsets_.reserve(size() + 1);
+  peerOffsets_.push_back(0);
+  for (int i = 0; i < size(); ++i) {
+    const int row = i / side_;
+    const int col = i % side_;
+    const int box = (row / subrows_) * subrows_ + col / subcols_;
+
+    // Peers are in ascending index order: the cells of the same row, column
+    // or box, other than the cell itself.
+    for (int j = 0; j < size(); ++j) {
+      const int jrow = j / side_;
+      const int jcol = j % side_;
+      const int jbox = (jrow / subrows_) * subrows_ + jcol / subcols_;
+      if (j != i && (jrow == row || jcol == col || jbox == box))
+        peers.push_back(j);
+    }
+    peerOffsets_.push_back(peers.size());
+
+    cellUnits_.push_back(row);
+    cellUnits_.push_back(side_ + col);
+    cellUnits_.push_back(2 * side_ + box);
+
+    units[row * side_ + col] = i;
+    units[(side_ + col) * side_ + row] = i;
+    units[(2 * side_ + box) * side_
+        + (row % subrows_) * subcols_ + col % subcols_] = i;
+  }
+
+  if (narrow_) {
+    narrowPeers_.assign(peers.begin(), peers.end());
+    narrowUnits_.assign(units.begin(), units.end());
+  } else {
+    widePeers_.swap(peers);
+    wideUnits_.swap(units);
+  }
+}
+
+CellRange GridLayout::getUnit(int unit) const {
+  if (isNarrow())
+    return CellRange(&narrowUnits_[unit * side_], nullptr, side_);
+  return CellRange(nullptr, &wideUnits_[unit * side_], side_);
+}
+
+CellRange GridLayout::getPeers(int index) const {
+  if (isNarrow())
+    return CellRange(getNarrowPeers(index), nullptr, getNumPeers(index));
+  return CellRange(nullptr, getWidePeers(index), getNumPeers(index));
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,150 @@
+/*
+ * grid_layout.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef GRID_LAYOUT_H_
+#define GRID_LAYOUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace sudoku {
+
+// Read-only view of a contiguous list of cell indices, stored as either
+// 16-bit or 32-bit integers.
+class CellRange {
+public:
+  class const_iterator {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef int reference;
+
+    const_iterator(const uint16_t* narrow, const int32_t* wide):
+        narrow_(narrow), wide_(wide) {}
+
+    int operator *() const { return narrow_ ? *narrow_ : *wide_; }
+    int operator [](difference_type n) const { return narrow_ ? narrow_[n] : wide_[n]; }
+    const_iterator& operator ++() { return *this += 1; }
+    const_iterator operator ++(int) { const_iterator old(*this); ++*this; return old; }
+    const_iterator& operator --() { return *this += -1; }
+    const_iterator operator --(int) { const_iterator old(*this); --*this; return old; }
+    const_iterator& operator +=(difference_type n);
+    const_iterator& operator -=(difference_type n) { return *this += -n; }
+    const_iterator operator +(difference_type n) const { return const_iterator(*this) += n; }
+    const_iterator operator -(difference_type n) const { return const_iterator(*this) += -n; }
+    difference_type operator -(const const_iterator& other) const;
+    bool operator ==(const const_iterator& other) const;
+    bool operator !=(const const_iterator& other) const { return !(*this == other); }
+    bool operator <(const const_iterator& other) const { return *this - other < 0; }
+
+  private:
+    const uint16_t* narrow_;
+    const int32_t* wide_;
+  };
+
+  typedef int value_type;
+  typedef const_iterator iterator;
+  typedef std::size_t size_type;
+
+  CellRange(const uint16_t* narrow, const int32_t* wide, int size):
+      narrow_(narrow), wide_(wide), size_(size) {}
+
+  const uint16_t* narrow() const { return narrow_; }
+  const int32_t* wide() const { return wide_; }
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  int operator [](int i) const { return narrow_ ? narrow_[i] : wide_[i]; }
+
+  const_iterator begin() const { return const_iterator(narrow_, wide_); }
+  const_iterator end() const;
+
+private:
+  const uint16_t* narrow_;
+  const int32_t* wide_;
+  int size_;
+};
+
+// Peer and unit (row, column, box) tables for one grid size. The tables are
+// immutable and interned: get() returns the same instance for every grid of
+// the same dimensions, in any thread. Peers are stored in CSR form, one
+// contiguous index array plus per-cell offsets; indices are 16-bit whenever
+// the grid has few enough cells.
+class GridLayout {
+public:
+  static std::shared_ptr<const GridLayout> get(int subrows, int subcols);
+
+  int getSubrows() const { return subrows_; }
+  int getSubcols() const { return subcols_; }
+  int getSide() const { return side_; }
+  int size() const { return side_ * side_; }
+  bool isNarrow() const { return narrow_; }
+
+  int getNumUnits() const { return 3 * side_; }
+  CellRange getUnit(int unit) const;
+  CellRange getPeers(int index) const;
+
+  // Typed access for loops that branch on isNarrow() once.
+  // Grids with no peers (1x1) get null pointers.
+  const uint16_t* getNarrowPeers(int index) const {
+    return narrowPeers_.data() + peerOffsets_[index];
+  }
+  const int32_t* getWidePeers(int index) const {
+    return widePeers_.data() + peerOffsets_[index];
+  }
+  int getNumPeers(int index) const {
+    return peerOffsets_[index + 1] - peerOffsets_[index];
+  }
+
+  // The row, column and box units containing a cell.
+  const int* getCellUnits(int index) const { return &cellUnits_[3 * index]; }
+
+private:
+  int subrows_, subcols_;
+  int side_;
+  // Whether the tables hold 16-bit indices, which depends only on the size
+  // (a 1x1 grid has no peers at all).
+  bool narrow_;
+  std::vector<int> peerOffsets_;
+  std::vector<int> cellUnits_;
+  std::vector<uint16_t> narrowPeers_, narrowUnits_;
+  std::vector<int32_t> widePeers_, wideUnits_;
+
+  GridLayout(int subrows, int subcols);
+};
+
+inline CellRange::const_iterator& CellRange::const_iterator::operator +=(
+    difference_type n) {
+  if (narrow_)
+    narrow_ += n;
+  else
+    wide_ += n;
+  return *this;
+}
+
+inline CellRange::const_iterator::difference_type
+CellRange::const_iterator::operator -(const const_iterator& other) const {
+  return narrow_ ? narrow_ - other.narrow_ : wide_ - other.wide_;
+}
+
+inline bool CellRange::const_iterator::operator ==(
+    const const_iterator& other) const {
+  return narrow_ == other.narrow_ && wide_ == other.wide_;
+}
+
+inline CellRange::const_iterator CellRange::end() const {
+  return narrow_ ? const_iterator(narrow_ + size_, nullptr)
+      : const_iterator(nullptr, wide_ + size_);
+}
+
+} /* namespace sudoku */
+
+#endif /* GRID_LAYOUT_H_ */
@@ -10,24 +10,59 @@
 #include <cstring>
 #include <cmath>
 
-#include <fstream>
-#include <iostream>
+#include <algorithm>
 #include <vector>
 #include <chrono>
+#include <memory>
+#include <thread>
+
+#include <pthread.h>
+#include <signal.h>
 
 #include <src/grid.h>
 #include <src/solver.h>
+#include <src/dlx_solver.h>
+#include <src/fixed_solver.h>
+#include <src/generator.h>
+#include <src/parallel_solver.h>
+#include <src/pipeline.h>
+#include <src/portfolio_solver.h>
+#include <src/puzzle_file.h>
+#include <src/puzzle_reader.h>
+#include <src/sat_solver.h>
+#include <src/server.h>
+#include <src/solution_cache.h>
+#include <src/solve_stats.h>
 
 using std::string;
 using std::vector;
-using std::istream;
-using std::ifstream;
 using std::locale;
 using std::chrono::high_resolution_clock;
 using std::chrono::duration_cast;
 using std::chrono::nanoseconds;
 using sudoku::Grid;
 using sudoku::Solver;
+using sudoku::DlxSolver;
+using sudoku::FixedSolver;
+using sudoku::Generator;
+using sudoku::ParallelSolver;
+using sudoku::Pipeline;
+using sudoku::PortfolioSolver;
+using sudoku::PuzzleFileReader;
+using sudoku::PuzzleFileWriter;
+using sudoku::PuzzleReader;
+using sudoku::PuzzleRecord;
+using sudoku::PropagationLevel;
+using sudoku::RestartPolicy;
+using sudoku::SatSolver;
+using sudoku::Server;
+using sudoku::SolutionCache;
+using sudoku::SolveLimits;
+using sudoku::SolveStats;
+using sudoku::SolveStatus;
+using sudoku::Symmetry;
+using sudoku::VariableSortType;
+using sudoku::ValueSortType;
 
 void printGrid(const Grid& grid) {
   int numberSpacing = floor(log10(grid.getMaxValue())) + 1;
@@ -44,103 +79,802 @@ void printGrid(const Grid& grid) {
   fflush(stdout);
 }
 
-int readGrid(istream& input, Grid& grid) {
-  int value;
-  for (int i = 0; i < grid.size(); ) {
-    if (input.peek() == EOF)
-      return i;
-    if (!(input >> value)) {
-      input.clear();
-      input.ignore(1);
-      continue;
+vector<int> toValues(const Grid& grid) {
+  vector<int> values(grid.size());
+  for (int i = 0; i < grid.size(); ++i)
+    values[i] = grid.getValues(i).size() == 1 ? grid.getValues(i).front() : 0;
+  return values;
+}
+
+// Formats values (0 for blanks) as one line, in a format readValues accepts.
+string formatValues(const vector<int>& values, int maxValue) {
+  string line;
+  for (int i = 0; i < (signed) values.size(); ++i) {
+    if (maxValue <= 9) {
+      line += values[i] ? '0' + values[i] : '.';
+    } else {
+      if (i > 0)
+        line += ' ';
+      line += std::to_string(values[i]);
     }
-    grid.assign(i++, value);
   }
-  return grid.size();
+  return line;
 }
 
-void printUsage() {
-  printf("Usage: sudoku-solver.exe [-d SUBROWS SUBCOLS] [FILE]\n");
+void printValues(const vector<int>& values, int maxValue) {
+  printf("%s\n", formatValues(values, maxValue).c_str());
 }
 
-// Main method
-// Args: [-d SUBROWS SUBCOLS] [FILE]
-int main(int argc, char **argv) {
+struct Input {
+  PuzzleReader text;
+  PuzzleFileReader binary;
+  bool isBinary = false;
+  bool fromStdin = false;
+};
+
+// Reads the values of the next grid; returns the number read, which is less
+// than size at the end of the input.
+int readValues(Input& input, int size, vector<int>& values) {
+  if (input.isBinary) {
+    PuzzleRecord record;
+    if (!input.binary.read(record))
+      return 0;
+    values = record.puzzle;
+    return size;
+  }
+  return input.text.read(values, size);
+}
+
+enum class Engine {
+  BACKTRACK, DLX, SAT
+};
+
+struct Options {
   int subrows = 3;
   int subcols = 3;
-  istream *input;
-  ifstream ifs;
+  PropagationLevel level = PropagationLevel::NAKED_SINGLES;
+  Engine engine = Engine::BACKTRACK;
+  int maxSolutions = -1;
+  int numThreads = 0;
+  int searchThreads = 0;
+  int portfolioThreads = 0;
+  bool fixedDimensions = true;
+  const char* outputPath = nullptr;
+  bool convert = false;
+  bool stats = false;
+  RestartPolicy restarts = RestartPolicy::NONE;
+  uint64_t seed = Solver::kDefaultSeed;
+  int numGenerated = 0;
+  Symmetry symmetry = Symmetry::ROTATIONAL;
+  const char* servePath = nullptr;
+  SolutionCache* cache = nullptr;
+  double timeout = 0;  // seconds per grid, or 0 for none
+};
 
-  int i = 1;
-  if (i < argc && !strcmp(argv[i], "-d")) {
-    i = 4;
-    if (*argv[2] == '\0' || *argv[3] == '\0') {
-      printf("Error: Not enough arguments after -d.\n");
-      printUsage();
+struct Task {
+  vector<int> values;
+  Grid grid;
+  Grid solution;
+  bool solved = false;
+  bool aborted = false;
+  int numSolutions = 0;
+  int steps = 0;
+  vector<int> threadSteps;
+  string winner;
+  long long ns = 0;
+  SolveStats stats;
+};
+
+// Solves with one of the engines, which all stop at the limits and report
+// how the solve ended.
+template <typename EngineSolver>
+SolveStatus runSolver(EngineSolver&& solver, const SolveLimits& limits,
+    Grid& solution, int& steps) {
+  solver.setLimits(limits);
+  solver.solve(solution, steps);
+  return solver.getStatus();
+}
+
+// Solves with a solver specialized for common grid dimensions when the
+// options allow it. Returns false if there is no such specialization.
+bool solveFixed(const Grid& grid, const Options& options,
+    const SolveLimits& limits, Grid& solution, int& steps,
+    SolveStatus& status) {
+  if (!options.fixedDimensions || options.searchThreads > 0
+      || options.portfolioThreads > 0
+      || options.level != PropagationLevel::NAKED_SINGLES)
+    return false;
+  if (grid.getSubrows() == 3 && grid.getSubcols() == 3) {
+    status = runSolver(FixedSolver<3, 3>(grid), limits, solution, steps);
+  } else if (grid.getSubrows() == 4 && grid.getSubcols() == 4) {
+    status = runSolver(FixedSolver<4, 4>(grid), limits, solution, steps);
+  } else if (grid.getSubrows() == 5 && grid.getSubcols() == 5) {
+    status = runSolver(FixedSolver<5, 5>(grid), limits, solution, steps);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// The multithreaded solvers (-t and --portfolio) take no limits.
+SolveStatus solveGrid(const Grid& grid, const Options& options,
+    const SolveLimits& limits, Grid& solution, int& steps,
+    vector<int>& threadSteps, string& winner) {
+  switch (options.engine) {
+  case Engine::DLX:
+    return runSolver(DlxSolver(grid), limits, solution, steps);
+  case Engine::SAT:
+    return runSolver(SatSolver(grid), limits, solution, steps);
+  default: {
+    bool solved;
+    if (options.portfolioThreads > 0) {
+      PortfolioSolver solver(grid, PortfolioSolver::getDefaultConfigs(
+          options.portfolioThreads, options.seed), options.level);
+      solved = solver.solve(solution, steps);
+      threadSteps = solver.getThreadSteps();
+      winner = toString(solver.getConfigs()[solver.getWinner()]);
+      return solved ? SolveStatus::SOLVED : SolveStatus::UNSOLVABLE;
+    }
+    SolveStatus status;
+    if (solveFixed(grid, options, limits, solution, steps, status))
+      return status;
+    if (options.searchThreads > 0) {
+      ParallelSolver solver(grid, options.searchThreads,
+          VariableSortType::MOST_CONSTRAINED,
+          ValueSortType::LEAST_CONSTRAINING, options.level);
+      solved = solver.solve(solution, steps);
+      threadSteps = solver.getThreadSteps();
+      return solved ? SolveStatus::SOLVED : SolveStatus::UNSOLVABLE;
+    }
+    return runSolver(Solver(grid, VariableSortType::MOST_CONSTRAINED,
+        ValueSortType::LEAST_CONSTRAINING, options.level), limits, solution,
+        steps);
+  }
+  }
+}
+
+void solveTask(Task& task, const Options& options) {
+  auto begin = high_resolution_clock::now();
+
+  SolveLimits limits;
+  if (options.timeout > 0) {
+    limits.deadline = std::chrono::steady_clock::now()
+        + duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(options.timeout));
+  }
+  SolveStatus status;
+  if (options.maxSolutions >= 0 || options.stats
+      || options.restarts != RestartPolicy::NONE) {
+    // Only the generic backtracking solver collects stats and restarts
+    // (which take a random value order to make each run different).
+    Solver solver(task.grid, VariableSortType::MOST_CONSTRAINED,
+        options.restarts != RestartPolicy::NONE ? ValueSortType::RANDOMIZED
+            : ValueSortType::LEAST_CONSTRAINING, options.level);
+    solver.setCollectStats(options.stats);
+    solver.setSeed(options.seed);
+    solver.setRestartPolicy(options.restarts);
+    solver.setLimits(limits);
+    SolveStats cacheStats;
+    if (options.maxSolutions >= 0) {
+      task.numSolutions = solver.countSolutions(task.steps,
+          options.maxSolutions);
+      status = solver.getStatus();
+    } else if (options.cache) {
+      status = options.cache->solve(solver, task.solution, task.steps,
+          &cacheStats);
+    } else {
+      solver.solve(task.solution, task.steps);
+      status = solver.getStatus();
+    }
+    task.stats = solver.getStats();
+    task.stats.cacheHits = cacheStats.cacheHits;
+    task.stats.cacheMisses = cacheStats.cacheMisses;
+    task.stats.canonicalizationNs = cacheStats.canonicalizationNs;
+  } else if (options.cache) {
+    status = options.cache->solve(task.grid, task.solution, task.steps,
+        [&](const Grid& grid, Grid& solution, int& steps) {
+      return solveGrid(grid, options, limits, solution, steps,
+          task.threadSteps, task.winner);
+    });
+  } else {
+    status = solveGrid(task.grid, options, limits, task.solution, task.steps,
+        task.threadSteps, task.winner);
+  }
+  task.solved = status == SolveStatus::SOLVED;
+  task.aborted = status == SolveStatus::ABORTED;
+
+  auto end = high_resolution_clock::now();
+  task.ns = duration_cast<nanoseconds>(end - begin).count();
+}
+
+void printTask(const Task& task, const Options& options) {
+  printf(" ||\n");
+  printf(" || (%d steps, %.3fs)\n", task.steps, task.ns / 1000000000.0);
+  if (!task.threadSteps.empty()) {
+    printf(" || (steps per thread:");
+    for (auto& steps : task.threadSteps)
+      printf(" %d", steps);
+    printf(")\n");
+  }
+  if (!task.winner.empty())
+    printf(" || (won by %s)\n", task.winner.c_str());
+  printf(" \\/\n");
+  if (options.maxSolutions >= 0) {
+    bool limited = task.aborted || (options.maxSolutions > 0
+        && task.numSolutions >= options.maxSolutions);
+    printf("[%d%s SOLUTION%s%s]\n", task.numSolutions, limited ? "+" : "",
+        task.numSolutions == 1 && !limited ? "" : "S",
+        task.aborted ? ", ABORTED" : "");
+  } else if (task.solved) {
+    printGrid(task.solution);
+  } else if (task.aborted) {
+    printf("[ABORTED]\n");
+  } else {
+    printf("[NO SOLUTION]\n");
+  }
+  printf("----\n");
+}
+
+// Prints a result's search stats as one JSON object.
+void printStats(int gridNumber, const Task& task, const Options& options) {
+  const SolveStats& stats = task.stats;
+  printf("{\"grid\": %d, ", gridNumber);
+  if (options.maxSolutions >= 0)
+    printf("\"solutions\": %d, ", task.numSolutions);
+  else
+    printf("\"solved\": %s, ", task.solved ? "true" : "false");
+  if (options.timeout > 0)
+    printf("\"aborted\": %s, ", task.aborted ? "true" : "false");
+  printf("\"steps\": %d, \"ns\": %lld, \"assignments\": %lld, "
+      "\"eliminations\": %lld, \"propagations\": %lld, \"dead_ends\": %lld, "
+      "\"backtracks\": %lld, \"restarts\": %lld, \"max_depth\": %d, "
+      "\"depth_nodes\": [", task.steps, task.ns, stats.assignments,
+      stats.eliminations, stats.propagations, stats.deadEnds, stats.backtracks,
+      stats.restarts, stats.maxDepth);
+  for (int i = 0; i < (signed) stats.depthNodes.size(); ++i)
+    printf(i == 0 ? "%lld" : ", %lld", stats.depthNodes[i]);
+  printf("], \"propagation_ns\": %lld, \"selection_ns\": %lld, "
+      "\"ordering_ns\": %lld", stats.propagationNs, stats.selectionNs,
+      stats.orderingNs);
+  if (options.cache) {
+    printf(", \"cache_hits\": %lld, \"cache_misses\": %lld, "
+        "\"canonicalization_ns\": %lld", stats.cacheHits, stats.cacheMisses,
+        stats.canonicalizationNs);
+  }
+  printf("}\n");
+  fflush(stdout);
+}
+
+// Writes a result to the binary output instead of printing it.
+void writeTask(PuzzleFileWriter& output, const Task& task,
+    const Options& options) {
+  PuzzleRecord record;
+  record.puzzle = task.values;
+  if (task.solved)
+    record.solution = toValues(task.solution);
+  record.steps = task.steps;
+  record.ns = task.ns;
+  record.numSolutions = options.maxSolutions >= 0 ? task.numSolutions
+      : task.solved;
+  output.write(record);
+}
+
+void printUsage() {
+  printf("Usage: sudoku-solver.exe [-d SUBROWS SUBCOLS] [-p LEVEL] [-e ENGINE]\n");
+  printf("                         [--count N] [-j THREADS] [-t THREADS] [--generic]\n");
+  printf("                         [-o OUTPUT] [--convert] [--stats]\n");
+  printf("                         [--restarts POLICY] [--seed N]\n");
+  printf("                         [--portfolio THREADS] [--cache N]\n");
+  printf("                         [--timeout SECONDS] [FILE]\n");
+  printf("       sudoku-solver.exe --generate N [-d SUBROWS SUBCOLS] [-j THREADS]\n");
+  printf("                         [--symmetry SYMMETRY] [--seed N] [-o OUTPUT]\n");
+  printf("       sudoku-solver.exe --serve SOCKET [-j THREADS] [solving options]\n");
+  printf("  -p LEVEL   propagation rules (0: naked singles, 1: hidden singles,\n");
+  printf("             2: locked candidates, 3: naked/hidden pairs)\n");
+  printf("  -e ENGINE  solving engine (backtrack, dlx, sat)\n");
+  printf("  --count N  count solutions up to N (0 for all) instead of solving\n");
+  printf("  -j THREADS solve grids in parallel (0 for one per core)\n");
+  printf("  -t THREADS search each grid on several threads (0 for one per core)\n");
+  printf("  --generic  don't use solvers specialized for 3x3, 4x4 and 5x5 subgrids\n");
+  printf("  -o OUTPUT  write results to OUTPUT in the binary format\n");
+  printf("  --convert  convert FILE between text and binary without solving\n");
+  printf("  --stats    print search stats for each grid as JSON lines\n");
+  printf("  --restarts POLICY\n");
+  printf("             randomize the value order and restart the search with\n");
+  printf("             growing step budgets (none, luby, geometric)\n");
+  printf("  --seed N   seed for the randomized value order\n");
+  printf("  --portfolio THREADS\n");
+  printf("             race different search heuristics on each grid, one per\n");
+  printf("             thread (0 for one per core)\n");
+  printf("  --cache N  reuse the solutions of up to N recent puzzles for\n");
+  printf("             equivalent ones (relabeled, reordered or transposed)\n");
+  printf("  --timeout SECONDS\n");
+  printf("             give up on a grid after SECONDS and report it aborted,\n");
+  printf("             with any -e engine (not with -t or --portfolio)\n");
+  printf("  --generate N\n");
+  printf("             print N new puzzles with unique solutions, one per line\n");
+  printf("  --symmetry SYMMETRY\n");
+  printf("             clue symmetry of generated puzzles (none, rotational,\n");
+  printf("             mirror)\n");
+  printf("  --serve SOCKET\n");
+  printf("             answer puzzles sent one per line to a Unix socket at\n");
+  printf("             SOCKET (- for stdin/stdout) with JSON lines, on -j\n");
+  printf("             threads (default one per core)\n");
+}
+
+// Formats a result as a JSON object for --serve.
+string formatResponse(const Task& task, const Options& options) {
+  char counts[128];
+  snprintf(counts, sizeof(counts), "%s\"steps\": %d, \"ns\": %lld}",
+      task.aborted ? "\"aborted\": true, " : "", task.steps, task.ns);
+  if (options.maxSolutions >= 0)
+    return "{\"solutions\": " + std::to_string(task.numSolutions) + ", "
+        + counts;
+  if (!task.solved)
+    return string("{\"solved\": false, ") + counts;
+  return "{\"solved\": true, \"solution\": \""
+      + formatValues(toValues(task.solution), task.solution.getMaxValue())
+      + "\", " + counts;
+}
+
+// Answers puzzles sent one per line until the input ends, or until SIGINT or
+// SIGTERM when listening on a socket. The server process keeps its worker
+// threads and the grid layouts it has built, so requests skip process
+// startup and table construction.
+void servePuzzles(const Options& options) {
+  const int gridSize = options.subrows * options.subcols
+      * options.subrows * options.subcols;
+  const int numThreads = options.numThreads > 0 ? options.numThreads
+      : std::max(1u, std::thread::hardware_concurrency());
+
+  // Blocked before the server starts its threads, which inherit the mask,
+  // so that only the thread waiting for them receives the signals.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  const bool listening = strcmp(options.servePath, "-") != 0;
+  if (listening)
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  Server server([&](const string& request) {
+    Task task;
+    const int numValues = sudoku::PuzzleReader::parseLine(request.data(),
+        request.data() + request.size(), gridSize, task.values);
+    if (numValues < gridSize) {
+      return "{\"error\": \"Incomplete definition (" + std::to_string(numValues)
+          + " values)\"}";
+    }
+    task.grid = Grid(options.subrows, options.subcols, task.values);
+    solveTask(task, options);
+    return formatResponse(task, options);
+  }, numThreads);
+
+  if (!listening) {
+    if (!server.serve(0, 1))
       exit(1);
+    return;
+  }
+  std::thread([&] {
+    int signal;
+    sigwait(&signals, &signal);
+    server.stop();
+  }).detach();
+  printf("Serving on %s with %d threads\n", options.servePath, numThreads);
+  fflush(stdout);
+  if (!server.listen(options.servePath)) {
+    printf("Error: Could not listen on socket.\n");
+    exit(1);
+  }
+}
+
+struct GeneratedPuzzle {
+  int number = 0;
+  vector<int> puzzle, solution;
+};
+
+// Generates options.numGenerated puzzles, printing them one per line or
+// writing them with their solutions to the output file, in order. Puzzle n
+// is generated from seed + n, so the output doesn't depend on the thread
+// count.
+void generatePuzzles(const Options& options) {
+  PuzzleFileWriter output;
+  if (options.outputPath && !output.open(options.outputPath, options.subrows,
+      options.subcols, sudoku::PuzzleFile::HAS_SOLUTION)) {
+    printf("Error: Could not create output file.\n");
+    printUsage();
+    exit(1);
+  }
+
+  auto generate = [&](GeneratedPuzzle& generated) {
+    Generator(options.subrows, options.subcols, options.symmetry,
+        options.seed + generated.number).generate(generated.puzzle,
+            generated.solution);
+  };
+  auto write = [&](const GeneratedPuzzle& generated) {
+    if (!output.isOpen()) {
+      printValues(generated.puzzle, options.subrows * options.subcols);
+      return;
     }
-    subrows = atoi(argv[2]);
-    subcols = atoi(argv[3]);
-    if (subrows == 0 || subcols == 0) {
-      printf("Error: Illegal subrow/col arguments (should be integers >0).\n");
+    PuzzleRecord record;
+    record.puzzle = generated.puzzle;
+    record.solution = generated.solution;
+    record.numSolutions = 1;
+    output.write(record);
+  };
+
+  auto begin = high_resolution_clock::now();
+  int numGenerated = 0;
+  if (options.numThreads > 0) {
+    Pipeline<GeneratedPuzzle> pipeline(options.numThreads,
+        64 * options.numThreads);
+    numGenerated = pipeline.run([&](GeneratedPuzzle& generated) {
+      generated.number = numGenerated++;
+      return generated.number < options.numGenerated;
+    }, generate, write);
+  } else {
+    for (; numGenerated < options.numGenerated; ++numGenerated) {
+      GeneratedPuzzle generated;
+      generated.number = numGenerated;
+      generate(generated);
+      write(generated);
+    }
+  }
+  auto end = high_resolution_clock::now();
+
+  if (output.isOpen() && !output.close()) {
+    printf("Error: Could not write output file.\n");
+  } else if (options.outputPath) {
+    printf("Generated %d grids (%.3fs)\n", numGenerated,
+        duration_cast<nanoseconds>(end - begin).count() / 1000000000.0);
+  }
+}
+
+// Main method
+// Args: [-d SUBROWS SUBCOLS] [-p LEVEL] [-e ENGINE] [--count N] [-j THREADS]
+//       [-t THREADS] [--generic] [-o OUTPUT] [--convert] [--stats]
+//       [--restarts POLICY] [--seed N] [--portfolio THREADS] [--cache N]
+//       [--timeout SECONDS] [FILE]
+//       --generate N [-d SUBROWS SUBCOLS] [-j THREADS] [--symmetry SYMMETRY]
+//       [--seed N] [-o OUTPUT]
+int main(int argc, char **argv) {
+  Options options;
+  Input input;
+  PuzzleFileWriter output;
+  int cacheSize = 0;
+
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; ++i) {
+    if (!strcmp(argv[i], "-d")) {
+      if (i + 2 >= argc || *argv[i + 1] == '\0' || *argv[i + 2] == '\0') {
+        printf("Error: Not enough arguments after -d.\n");
+        printUsage();
+        exit(1);
+      }
+      options.subrows = atoi(argv[++i]);
+      options.subcols = atoi(argv[++i]);
+      if (options.subrows <= 0 || options.subcols <= 0) {
+        printf("Error: Illegal subrow/col arguments (should be integers >0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "-p")) {
+      int arg = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (arg < 0 || arg > (int) PropagationLevel::PAIRS) {
+        printf("Error: Illegal propagation level (should be 0-3).\n");
+        printUsage();
+        exit(1);
+      }
+      options.level = static_cast<PropagationLevel>(arg);
+    } else if (!strcmp(argv[i], "-e")) {
+      const char* arg = i + 1 < argc ? argv[++i] : "";
+      if (!strcmp(arg, "backtrack")) {
+        options.engine = Engine::BACKTRACK;
+      } else if (!strcmp(arg, "dlx")) {
+        options.engine = Engine::DLX;
+      } else if (!strcmp(arg, "sat")) {
+        options.engine = Engine::SAT;
+      } else {
+        printf("Error: Unknown engine (should be backtrack, dlx or sat).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--count")) {
+      options.maxSolutions = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (options.maxSolutions < 0) {
+        printf("Error: Illegal solution count (should be an integer >=0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "-j")) {
+      options.numThreads = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (options.numThreads < 0) {
+        printf("Error: Illegal thread count (should be an integer >=0).\n");
+        printUsage();
+        exit(1);
+      }
+      if (options.numThreads == 0)
+        options.numThreads = std::max(1u, std::thread::hardware_concurrency());
+    } else if (!strcmp(argv[i], "-t")) {
+      options.searchThreads = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (options.searchThreads < 0) {
+        printf("Error: Illegal thread count (should be an integer >=0).\n");
+        printUsage();
+        exit(1);
+      }
+      if (options.searchThreads == 0)
+        options.searchThreads = std::max(1u,
+            std::thread::hardware_concurrency());
+    } else if (!strcmp(argv[i], "--portfolio")) {
+      options.portfolioThreads = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (options.portfolioThreads < 0) {
+        printf("Error: Illegal thread count (should be an integer >=0).\n");
+        printUsage();
+        exit(1);
+      }
+      if (options.portfolioThreads == 0) {
+        options.portfolioThreads = std::max(1u,
+            std::thread::hardware_concurrency());
+      }
+    } else if (!strcmp(argv[i], "--generate")) {
+      options.numGenerated = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (options.numGenerated <= 0) {
+        printf("Error: Illegal puzzle count (should be an integer >0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--symmetry")) {
+      const char* arg = i + 1 < argc ? argv[++i] : "";
+      if (!strcmp(arg, "none")) {
+        options.symmetry = Symmetry::NONE;
+      } else if (!strcmp(arg, "rotational")) {
+        options.symmetry = Symmetry::ROTATIONAL;
+      } else if (!strcmp(arg, "mirror")) {
+        options.symmetry = Symmetry::MIRROR;
+      } else {
+        printf("Error: Unknown symmetry (should be none, rotational or mirror).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--serve")) {
+      if (i + 1 >= argc || *argv[i + 1] == '\0') {
+        printf("Error: Not enough arguments after --serve.\n");
+        printUsage();
+        exit(1);
+      }
+      options.servePath = argv[++i];
+    } else if (!strcmp(argv[i], "--cache")) {
+      cacheSize = i + 1 < argc ? atoi(argv[++i]) : -1;
+      if (cacheSize <= 0) {
+        printf("Error: Illegal cache size (should be an integer >0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--generic")) {
+      options.fixedDimensions = false;
+    } else if (!strcmp(argv[i], "-o")) {
+      if (i + 1 >= argc || *argv[i + 1] == '\0') {
+        printf("Error: Not enough arguments after -o.\n");
+        printUsage();
+        exit(1);
+      }
+      options.outputPath = argv[++i];
+    } else if (!strcmp(argv[i], "--convert")) {
+      options.convert = true;
+    } else if (!strcmp(argv[i], "--stats")) {
+      options.stats = true;
+    } else if (!strcmp(argv[i], "--restarts")) {
+      const char* arg = i + 1 < argc ? argv[++i] : "";
+      if (!strcmp(arg, "none")) {
+        options.restarts = RestartPolicy::NONE;
+      } else if (!strcmp(arg, "luby")) {
+        options.restarts = RestartPolicy::LUBY;
+      } else if (!strcmp(arg, "geometric")) {
+        options.restarts = RestartPolicy::GEOMETRIC;
+      } else {
+        printf("Error: Unknown restart policy (should be none, luby or geometric).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--timeout")) {
+      options.timeout = i + 1 < argc ? atof(argv[++i]) : -1;
+      if (options.timeout <= 0) {
+        printf("Error: Illegal timeout (should be a number of seconds >0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else if (!strcmp(argv[i], "--seed")) {
+      const char* arg = i + 1 < argc ? argv[++i] : "";
+      char* end;
+      options.seed = strtoull(arg, &end, 10);
+      if (*arg < '0' || *arg > '9' || *end != '\0') {
+        printf("Error: Illegal seed (should be an integer >=0).\n");
+        printUsage();
+        exit(1);
+      }
+    } else {
+      printf("Error: Unknown option %s.\n", argv[i]);
       printUsage();
       exit(1);
     }
   }
 
+  if ((options.maxSolutions >= 0 || options.stats
+      || options.restarts != RestartPolicy::NONE)
+      && (options.engine != Engine::BACKTRACK || options.searchThreads > 0)) {
+    printf("Error: --count, --stats and --restarts need the backtracking engine without -t.\n");
+    printUsage();
+    exit(1);
+  }
+  if (options.timeout > 0 && options.searchThreads > 0) {
+    printf("Error: --timeout can't be combined with -t.\n");
+    printUsage();
+    exit(1);
+  }
+  if (options.portfolioThreads > 0 && (options.engine != Engine::BACKTRACK
+      || options.searchThreads > 0 || options.maxSolutions >= 0
+      || options.stats || options.restarts != RestartPolicy::NONE
+      || options.timeout > 0)) {
+    printf("Error: --portfolio can't be combined with -e, -t, --count, --stats, --restarts or --timeout.\n");
+    printUsage();
+    exit(1);
+  }
+  if (cacheSize > 0 && options.maxSolutions >= 0) {
+    printf("Error: --cache can't be combined with --count.\n");
+    printUsage();
+    exit(1);
+  }
+  std::unique_ptr<SolutionCache> cache;
+  if (cacheSize > 0) {
+    cache.reset(new SolutionCache(cacheSize));
+    options.cache = cache.get();
+  }
+  if (options.servePath && (options.outputPath || options.convert
+      || options.stats || options.numGenerated > 0)) {
+    printf("Error: --serve can't be combined with -o, --convert, --stats or --generate.\n");
+    printUsage();
+    exit(1);
+  }
+  if (options.numGenerated > 0) {
+    generatePuzzles(options);
+    exit(0);
+  }
+  if (options.servePath) {
+    servePuzzles(options);
+    exit(0);
+  }
+  if (options.stats && !SolveStats::kEnabled)
+    fprintf(stderr, "Warning: Built without SUDOKU_STATS; stats are zero.\n");
+
   if (i < argc && *argv[i] != '\0') {
-    ifs.open(argv[i]);
-    if (!ifs.is_open()) {
+    input.isBinary = sudoku::PuzzleFile::isBinary(argv[i]);
+    if (input.isBinary ? !input.binary.open(argv[i])
+        : !input.text.open(argv[i])) {
       printf("Error: Could not open file.\n");
       printUsage();
       exit(1);
     }
-    input = &ifs;
+    if (input.isBinary) {
+      options.subrows = input.binary.getSubrows();
+      options.subcols = input.binary.getSubcols();
+    }
   } else {
-    input = &std::cin;
-    printf("Enter the grid as a list of values (0 for blank):\n");
+    input.text.openDescriptor(0);
+    input.fromStdin = true;
+    if (!options.convert && !options.stats)
+      printf("Enter the grid as a list of values (0 for blank):\n");
+  }
+
+  if (options.outputPath) {
+    const int flags = options.convert ? 0
+        : sudoku::PuzzleFile::HAS_SOLUTION | sudoku::PuzzleFile::HAS_STATS;
+    if (!output.open(options.outputPath, options.subrows, options.subcols,
+        flags)) {
+      printf("Error: Could not create output file.\n");
+      printUsage();
+      exit(1);
+    }
   }
 
+  const int gridSize = options.subrows * options.subcols
+      * options.subrows * options.subcols;
   int completedGrids = 0;
+  int abortedGrids = 0;
+  int numValues = 0;
   double totalNs = 0;
-  while (true) {
-    Grid grid(subrows, subcols);
-    int numValues = readGrid(*input, grid);
-    if (numValues < grid.size()) {
-      if (numValues > 0 || completedGrids == 0)
+  while (options.convert) {
+    vector<int> values;
+    numValues = readValues(input, gridSize, values);
+    if (numValues < gridSize) {
+      if (numValues > 0)
         printf("Warning: Incomplete definition (%d values).\n", numValues);
       break;
     }
-    if (input != &std::cin)
-      printGrid(grid);
+    if (output.isOpen()) {
+      PuzzleRecord record;
+      record.puzzle = values;
+      output.write(record);
+    } else {
+      printValues(values, options.subrows * options.subcols);
+    }
+    completedGrids++;
+  }
+  if (options.convert) {
+    if (output.isOpen() && !output.close())
+      printf("Error: Could not write output file.\n");
+    else if (options.outputPath)
+      printf("Converted %d grids\n", completedGrids);
+    exit(0);
+  }
 
+  if (options.numThreads > 0) {
     auto begin = high_resolution_clock::now();
-
-    Solver solver(grid);
-    Grid solution;
-    int steps;
-    bool solved = solver.solve(solution, steps);
-
+    int numPrinted = 0;
+    Pipeline<Task> pipeline(options.numThreads, 64 * options.numThreads);
+    completedGrids = pipeline.run([&](Task& task) {
+      numValues = readValues(input, gridSize, task.values);
+      if (numValues < gridSize)
+        return false;
+      task.grid = Grid(options.subrows, options.subcols, task.values);
+      return true;
+    }, [&](Task& task) {
+      solveTask(task, options);
+    }, [&](const Task& task) {
+      abortedGrids += task.aborted;
+      if (options.stats)
+        printStats(++numPrinted, task, options);
+      if (output.isOpen()) {
+        writeTask(output, task, options);
+        return;
+      }
+      if (options.stats)
+        return;
+      if (!input.fromStdin)
+        printGrid(task.grid);
+      printTask(task, options);
+    });
     auto end = high_resolution_clock::now();
-    auto ns = duration_cast<nanoseconds>(end - begin).count();
-    totalNs += ns;
-
-    printf(" ||\n");
-    printf(" || (%d steps, %.3fs)\n", steps, ns / 1000000000.0);
-    printf(" \\/\n");
-    if (solved) {
-      printGrid(solution);
-    } else {
-      printf("[NO SOLUTION]\n");
+    totalNs = duration_cast<nanoseconds>(end - begin).count();
+    if (numValues > 0 || completedGrids == 0)
+      printf("Warning: Incomplete definition (%d values).\n", numValues);
+  }
+
+  while (options.numThreads == 0) {
+    Task task;
+    numValues = readValues(input, gridSize, task.values);
+    if (numValues < gridSize) {
+      if (numValues > 0 || completedGrids == 0)
+        printf("Warning: Incomplete definition (%d values).\n", numValues);
+      break;
     }
-    printf("----\n");
+    task.grid = Grid(options.subrows, options.subcols, task.values);
+    if (!input.fromStdin && !output.isOpen() && !options.stats)
+      printGrid(task.grid);
 
+    solveTask(task, options);
+    totalNs += task.ns;
     completedGrids++;
+    abortedGrids += task.aborted;
+    if (options.stats)
+      printStats(completedGrids, task, options);
+    if (output.isOpen())
+      writeTask(output, task, options);
+    else if (!options.stats)
+      printTask(task, options);
+  }
+  if (!options.stats) {
+    printf("Solved %d grids (%.3fs)", completedGrids, totalNs / 1000000000.0);
+    if (abortedGrids > 0)
+      printf(" (%d aborted)", abortedGrids);
+    if (options.cache) {
+      printf(" (cache: %lld hits, %lld misses, %.3fs canonicalizing)",
+          options.cache->getHits(), options.cache->getMisses(),
+          options.cache->getCanonicalizationNs() / 1000000000.0);
+    }
   }
-  printf("Solved %d grids (%.3fs)", completedGrids, totalNs / 1000000000.0);
 
-  if (ifs.is_open())
-    ifs.close();
+  if (output.isOpen() && !output.close())
+    printf("\nError: Could not write output file.\n");
 
   exit(0);
 }
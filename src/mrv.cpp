@@ -0,0 +1,136 @@
+/*
+ * mrv.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+
+#include <src/mrv.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SUDOKU_MRV_X86 1
+#include <immintrin.h>
+#endif
+
+namespace sudoku {
+
+namespace {
+
+typedef int (*Kernel)(const uint16_t* keys, int n);
+
+int findMinKeyScalar(const uint16_t* keys, int n) {
+  int minIndex = -1;
+  uint16_t minKey = kMrvSkipKey;
+  for (int i = 0; i < n; ++i) {
+    if (keys[i] < minKey) {
+      minKey = keys[i];
+      minIndex = i;
+    }
+  }
+  return minIndex;
+}
+
+#ifdef SUDOKU_MRV_X86
+
+// The vector kernels make two passes: a branch-free minimum over all keys,
+// then a search for the first key equal to it, which usually stops early.
+
+__attribute__((target("sse4.1")))
+int findMinKeySse41(const uint16_t* keys, int n) {
+  int i = 0;
+  __m128i mins = _mm_set1_epi16(-1);
+  for (; i + 8 <= n; i += 8)
+    mins = _mm_min_epu16(mins,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)));
+  uint16_t minKey = _mm_extract_epi16(_mm_minpos_epu16(mins), 0);
+  for (; i < n; ++i)
+    minKey = std::min(minKey, keys[i]);
+  if (minKey == kMrvSkipKey)
+    return -1;
+
+  const __m128i target = _mm_set1_epi16(minKey);
+  for (i = 0; i + 8 <= n; i += 8) {
+    const int mask = _mm_movemask_epi8(_mm_cmpeq_epi16(target,
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i))));
+    if (mask)
+      return i + __builtin_ctz(mask) / 2;
+  }
+  for (; keys[i] != minKey; ++i)
+    ;
+  return i;
+}
+
+__attribute__((target("avx2")))
+int findMinKeyAvx2(const uint16_t* keys, int n) {
+  int i = 0;
+  __m256i mins = _mm256_set1_epi16(-1);
+  for (; i + 16 <= n; i += 16)
+    mins = _mm256_min_epu16(mins,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i)));
+  const __m128i halves = _mm_min_epu16(_mm256_castsi256_si128(mins),
+      _mm256_extracti128_si256(mins, 1));
+  uint16_t minKey = _mm_extract_epi16(_mm_minpos_epu16(halves), 0);
+  for (; i < n; ++i)
+    minKey = std::min(minKey, keys[i]);
+  if (minKey == kMrvSkipKey)
+    return -1;
+
+  const __m256i target = _mm256_set1_epi16(minKey);
+  for (i = 0; i + 16 <= n; i += 16) {
+    const unsigned int mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(target,
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i))));
+    if (mask)
+      return i + __builtin_ctz(mask) / 2;
+  }
+  for (; keys[i] != minKey; ++i)
+    ;
+  return i;
+}
+
+#endif
+
+Kernel getKernel(MrvKernel kernel) {
+#ifdef SUDOKU_MRV_X86
+  if (kernel == MrvKernel::AVX2 && isSupported(kernel))
+    return findMinKeyAvx2;
+  if (kernel == MrvKernel::SSE41 && isSupported(kernel))
+    return findMinKeySse41;
+#endif
+  return findMinKeyScalar;
+}
+
+} /* namespace */
+
+bool isSupported(MrvKernel kernel) {
+  switch (kernel) {
+#ifdef SUDOKU_MRV_X86
+  case MrvKernel::AVX2:
+    return __builtin_cpu_supports("avx2");
+  case MrvKernel::SSE41:
+    return __builtin_cpu_supports("sse4.1");
+#endif
+  case MrvKernel::SCALAR:
+    return true;
+  default:
+    return false;
+  }
+}
+
+MrvKernel getBestMrvKernel() {
+  static const MrvKernel best = isSupported(MrvKernel::AVX2) ? MrvKernel::AVX2
+      : isSupported(MrvKernel::SSE41) ? MrvKernel::SSE41 : MrvKernel::SCALAR;
+  return best;
+}
+
+int findMinKey(const uint16_t* keys, int n) {
+  static const Kernel kernel = getKernel(getBestMrvKernel());
+  return kernel(keys, n);
+}
+
+int findMinKey(const uint16_t* keys, int n, MrvKernel kernel) {
+  return getKernel(kernel)(keys, n);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,37 @@
+/*
+ * mrv.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef MRV_H_
+#define MRV_H_
+
+#include <cstdint>
+
+namespace sudoku {
+
+// Key of a cell that is never selected (one with a single candidate).
+const uint16_t kMrvSkipKey = 0xFFFF;
+
+// Implementations of the minimum remaining values scan. The vector kernels
+// are compiled for their instruction sets and picked at runtime, so one
+// binary runs on any x86-64 CPU (and everything falls back to SCALAR on
+// other architectures).
+enum class MrvKernel {
+  SCALAR, SSE41, AVX2
+};
+
+bool isSupported(MrvKernel kernel);
+// The fastest kernel the CPU supports.
+MrvKernel getBestMrvKernel();
+
+// Returns the index of the first smallest of n keys, ignoring kMrvSkipKey,
+// or -1 if every key is kMrvSkipKey. All kernels return the same index.
+int findMinKey(const uint16_t* keys, int n);
+int findMinKey(const uint16_t* keys, int n, MrvKernel kernel);
+
+} /* namespace sudoku */
+
+#endif /* MRV_H_ */
@@ -0,0 +1,165 @@
+/*
+ * parallel_solver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <thread>
+
+#include <src/parallel_solver.h>
+
+using std::vector;
+
+namespace sudoku {
+
+ParallelSolver::ParallelSolver(Grid grid, int numThreads,
+    VariableSortType varSortType, ValueSortType valSortType,
+    PropagationLevel level):
+    grid_(grid), found_(false), pending_(0), idle_(0) {
+
+  numThreads_ = numThreads < 1 ? 1 : numThreads;
+  varSortType_ = varSortType;
+  valSortType_ = valSortType;
+  level_ = level;
+}
+
+bool ParallelSolver::solve(Grid& solution, int& steps) {
+  steps = 0;
+  threadSteps_.assign(numThreads_, 0);
+
+  Grid root(grid_);
+  root.clearTrail();
+  root.setPropagationLevel(level_);
+  if (!root.propagate())
+    return false;
+
+  const Solver solver(grid_, varSortType_, valSortType_, level_);
+  workers_.clear();
+  for (int i = 0; i < numThreads_; ++i) {
+    workers_.emplace_back(new Worker(solver));
+    // So randomized orderings differ between workers.
+    workers_.back()->solver.setSeed(Solver::kDefaultSeed + i);
+  }
+  found_ = false;
+  idle_ = 0;
+  pending_ = 1;
+  workers_[0]->tasks.push_back({ root, -1, 0 });
+
+  vector<std::thread> threads;
+  for (int i = 1; i < numThreads_; ++i)
+    threads.emplace_back(&ParallelSolver::run, this, i);
+  run(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int i = 0; i < numThreads_; ++i) {
+    threadSteps_[i] = workers_[i]->steps;
+    steps += threadSteps_[i];
+  }
+  workers_.clear();
+
+  if (!found_)
+    return false;
+  solution = solution_;
+  return true;
+}
+
+void ParallelSolver::run(int id) {
+  Worker& worker = *workers_[id];
+  Task task;
+  while (!found_ && pending_ > 0) {
+    if (popLocal(worker, task) || steal(id, task)) {
+      execute(worker, task);
+      pending_--;
+    } else {
+      idle_++;
+      std::this_thread::yield();
+      idle_--;
+    }
+  }
+}
+
+void ParallelSolver::push(Worker& worker, Task task) {
+  pending_++;
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  worker.tasks.push_back(std::move(task));
+}
+
+// Owners take their newest task, keeping work local and depth-first.
+bool ParallelSolver::popLocal(Worker& worker, Task& task) {
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty())
+    return false;
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  return true;
+}
+
+// Thieves take the oldest task of another worker, which is the one closest
+// to the root and so likely the largest subtree.
+bool ParallelSolver::steal(int id, Task& task) {
+  for (int i = 1; i < numThreads_; ++i) {
+    Worker& victim = *workers_[(id + i) % numThreads_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty())
+      continue;
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void ParallelSolver::execute(Worker& worker, Task& task) {
+  if (task.index != -1) {
+    worker.steps++;
+    if (!task.grid.assign(task.index, task.value))
+      return;
+  }
+  search(worker, task.grid);
+}
+
+// Returns true if the search should stop, either from finding a solution or
+// from another worker having found one.
+bool ParallelSolver::search(Worker& worker, Grid& grid) {
+  if (found_)
+    return true;
+
+  int index = worker.solver.selectIndex(grid);
+
+  if (index == -1) {
+    std::lock_guard<std::mutex> lock(solutionMutex_);
+    if (!found_) {
+      solution_ = grid;
+      solution_.clearTrail();
+      found_ = true;
+    }
+    return true;
+  }
+
+  vector<int> moves(grid.getValues(index).begin(),
+      grid.getValues(index).end());
+  worker.solver.sortMoves(grid, moves.data(), moves.size(), index);
+
+  const int mark = grid.getTrailMark();
+  for (unsigned int i = 0; i < moves.size(); ++i) {
+    if (i + 1 < moves.size() && idle_ > 0) {
+      Grid shared(grid);
+      shared.clearTrail();
+      for (unsigned int j = moves.size() - 1; j > i; --j)
+        push(worker, { shared, index, moves[j] });
+      moves.resize(i + 1);
+    }
+
+    worker.steps++;
+
+    if (grid.assign(index, moves[i]) && search(worker, grid))
+      return true;
+    grid.rollback(mark);
+  }
+
+  return found_;
+}
+
+} /* namespace sudoku */
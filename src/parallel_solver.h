@@ -0,0 +1,83 @@
+/*
+ * parallel_solver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef PARALLEL_SOLVER_H_
+#define PARALLEL_SOLVER_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Searches a single grid on several threads. Each worker runs the same
+// depth-first search as Solver; when other workers are idle, the untried
+// branches at a node are handed out as tasks on the worker's deque, which
+// idle workers steal from. The first solution found cancels the others.
+class ParallelSolver {
+public:
+  ParallelSolver(Grid grid, int numThreads,
+      VariableSortType varSortType = VariableSortType::MOST_CONSTRAINED,
+      ValueSortType valSortType = ValueSortType::LEAST_CONSTRAINING,
+      PropagationLevel level = PropagationLevel::NAKED_SINGLES);
+
+  const Grid& getGrid() const { return grid_; }
+  int getNumThreads() const { return numThreads_; }
+
+  // Steps taken by each thread in the last solve.
+  const std::vector<int>& getThreadSteps() const { return threadSteps_; }
+
+  bool solve(Grid& solution, int& steps);
+
+private:
+  // Subtree rooted at assigning value to index in grid (index -1 for the
+  // root of the search).
+  struct Task {
+    Grid grid;
+    int index;
+    int value;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    Solver solver;
+    int steps;
+
+    explicit Worker(const Solver& solver): solver(solver), steps(0) {}
+  };
+
+  Grid grid_;
+  int numThreads_;
+  VariableSortType varSortType_;
+  ValueSortType valSortType_;
+  PropagationLevel level_;
+  std::vector<int> threadSteps_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> found_;
+  std::atomic<int> pending_;
+  std::atomic<int> idle_;
+  std::mutex solutionMutex_;
+  Grid solution_;
+
+  void run(int id);
+  void push(Worker& worker, Task task);
+  bool popLocal(Worker& worker, Task& task);
+  bool steal(int id, Task& task);
+  void execute(Worker& worker, Task& task);
+  bool search(Worker& worker, Grid& grid);
+};
+
+} /* namespace sudoku */
+
+#endif /* PARALLEL_SOLVER_H_ */
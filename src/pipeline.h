@@ -0,0 +1,172 @@
+/*
+ * pipeline.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sudoku {
+
+// Blocking FIFO queue with a fixed capacity. Pushing to a full queue waits
+// for room; popping from an empty queue waits for an item or for close().
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(int capacity): capacity_(capacity), closed_(false) {}
+
+  bool push(T item);
+  bool pop(T& item);
+  void close();
+
+private:
+  std::mutex mutex_;
+  std::condition_variable notEmpty_, notFull_;
+  std::deque<T> items_;
+  unsigned int capacity_;
+  bool closed_;
+};
+
+// Three-stage pipeline: one reader fills items, a pool of workers processes
+// them, and the calling thread writes them back out in input order. At most
+// `capacity` items are in flight, so unbounded inputs use bounded memory.
+template <typename T>
+class Pipeline {
+public:
+  typedef std::function<bool(T&)> Reader;
+  typedef std::function<void(T&)> Processor;
+  typedef std::function<void(const T&)> Writer;
+
+  Pipeline(int numWorkers, int capacity);
+
+  long run(const Reader& read, const Processor& process, const Writer& write);
+
+private:
+  struct Slot {
+    T item;
+    bool ready;
+  };
+
+  int numWorkers_;
+  int capacity_;
+};
+
+template <typename T>
+bool BoundedQueue<T>::push(T item) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  notFull_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+  if (closed_)
+    return false;
+  items_.push_back(std::move(item));
+  notEmpty_.notify_one();
+  return true;
+}
+
+template <typename T>
+bool BoundedQueue<T>::pop(T& item) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  notEmpty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+  if (items_.empty())
+    return false;
+  item = std::move(items_.front());
+  items_.pop_front();
+  notFull_.notify_one();
+  return true;
+}
+
+template <typename T>
+void BoundedQueue<T>::close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  closed_ = true;
+  notEmpty_.notify_all();
+  notFull_.notify_all();
+}
+
+template <typename T>
+Pipeline<T>::Pipeline(int numWorkers, int capacity):
+    numWorkers_(numWorkers < 1 ? 1 : numWorkers),
+    capacity_(capacity < 1 ? 1 : capacity) {
+}
+
+template <typename T>
+long Pipeline<T>::run(const Reader& read, const Processor& process,
+    const Writer& write) {
+  std::vector<Slot> slots(capacity_, Slot { T(), false });
+  BoundedQueue<long> queue(capacity_);
+  std::mutex mutex;
+  std::condition_variable changed;
+  long numRead = 0, numWritten = 0;
+  bool doneReading = false;
+
+  std::thread reader([&] {
+    for (long id = 0; ; ++id) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return id - numWritten < capacity_; });
+      }
+      Slot& slot = slots[id % capacity_];
+      if (!read(slot.item))
+        break;
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        numRead = id + 1;
+      }
+      queue.push(id);
+    }
+    queue.close();
+    std::lock_guard<std::mutex> lock(mutex);
+    doneReading = true;
+    changed.notify_all();
+  });
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < numWorkers_; ++i) {
+    workers.emplace_back([&] {
+      long id;
+      while (queue.pop(id)) {
+        Slot& slot = slots[id % capacity_];
+        process(slot.item);
+        std::lock_guard<std::mutex> lock(mutex);
+        slot.ready = true;
+        changed.notify_all();
+      }
+    });
+  }
+
+  while (true) {
+    Slot* slot;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      changed.wait(lock, [&] {
+        return (numWritten < numRead && slots[numWritten % capacity_].ready)
+            || (doneReading && numWritten == numRead);
+      });
+      if (numWritten == numRead)
+        break;
+      slot = &slots[numWritten % capacity_];
+    }
+    write(slot->item);
+    std::lock_guard<std::mutex> lock(mutex);
+    slot->ready = false;
+    numWritten++;
+    changed.notify_all();
+  }
+
+  reader.join();
+  for (auto& worker : workers)
+    worker.join();
+  return numWritten;
+}
+
+} /* namespace sudoku */
+
+#endif /* PIPELINE_H_ */
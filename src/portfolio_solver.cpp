@@ -0,0 +1,132 @@
+/*
+ * portfolio_solver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include <src/portfolio_solver.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+const char* toString(VariableSortType type) {
+  switch (type) {
+  case VariableSortType::RANDOMIZED:
+    return "randomized";
+  case VariableSortType::MOST_CONSTRAINED:
+    return "most_constrained";
+  default:
+    return "none";
+  }
+}
+
+const char* toString(ValueSortType type) {
+  switch (type) {
+  case ValueSortType::RANDOMIZED:
+    return "randomized";
+  case ValueSortType::LEAST_CONSTRAINING:
+    return "least_constraining";
+  default:
+    return "none";
+  }
+}
+
+const char* toString(RestartPolicy policy) {
+  switch (policy) {
+  case RestartPolicy::LUBY:
+    return "luby";
+  case RestartPolicy::GEOMETRIC:
+    return "geometric";
+  default:
+    return "none";
+  }
+}
+
+} /* namespace */
+
+string toString(const PortfolioConfig& config) {
+  string name = string(toString(config.varSortType)) + "/"
+      + toString(config.valSortType) + "/" + toString(config.restartPolicy);
+  if (config.valSortType == ValueSortType::RANDOMIZED
+      || config.varSortType == VariableSortType::RANDOMIZED)
+    name += "/seed=" + std::to_string(config.seed);
+  return name;
+}
+
+PortfolioSolver::PortfolioSolver(Grid grid, vector<PortfolioConfig> configs,
+    PropagationLevel level):
+    grid_(grid), configs_(configs), level_(level), winner_(-1) {
+  if (configs_.empty())
+    configs_ = getDefaultConfigs(1);
+}
+
+vector<PortfolioConfig> PortfolioSolver::getDefaultConfigs(int numConfigs,
+    uint64_t seed) {
+  vector<PortfolioConfig> configs = {
+    {VariableSortType::MOST_CONSTRAINED, ValueSortType::LEAST_CONSTRAINING,
+        RestartPolicy::NONE, seed},
+    {VariableSortType::MOST_CONSTRAINED, ValueSortType::RANDOMIZED,
+        RestartPolicy::LUBY, seed},
+    {VariableSortType::MOST_CONSTRAINED, ValueSortType::NONE,
+        RestartPolicy::NONE, seed},
+    {VariableSortType::MOST_CONSTRAINED, ValueSortType::RANDOMIZED,
+        RestartPolicy::GEOMETRIC, seed + 1},
+  };
+  for (int i = configs.size(); i < numConfigs; ++i) {
+    configs.push_back({VariableSortType::MOST_CONSTRAINED,
+        ValueSortType::RANDOMIZED, i % 2 ? RestartPolicy::GEOMETRIC
+            : RestartPolicy::LUBY, seed + i / 2});
+  }
+  configs.resize(numConfigs < 1 ? 1 : numConfigs);
+  return configs;
+}
+
+bool PortfolioSolver::solve(Grid& solution, int& steps) {
+  std::atomic<bool> done(false);
+  std::mutex mutex;
+  bool solved = false;
+  winner_ = -1;
+  threadSteps_.assign(configs_.size(), 0);
+
+  auto race = [&](int id) {
+    const PortfolioConfig& config = configs_[id];
+    Solver solver(grid_, config.varSortType, config.valSortType, level_);
+    solver.setSeed(config.seed);
+    solver.setRestartPolicy(config.restartPolicy);
+    solver.setCancelFlag(&done);
+
+    Grid result;
+    const bool found = solver.solve(result, threadSteps_[id]);
+    // Solvers only stop without a solution after a winner cancelled them,
+    // or once they have ruled every move out.
+    std::lock_guard<std::mutex> lock(mutex);
+    if (winner_ != -1)
+      return;
+    winner_ = id;
+    solved = found;
+    if (found)
+      solution = result;
+    steps = threadSteps_[id];
+    done = true;
+  };
+
+  vector<std::thread> threads;
+  for (int i = 1; i < (signed) configs_.size(); ++i)
+    threads.emplace_back(race, i);
+  race(0);
+  for (auto& thread : threads)
+    thread.join();
+
+  return solved;
+}
+
+} /* namespace sudoku */
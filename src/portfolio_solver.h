@@ -0,0 +1,67 @@
+/*
+ * portfolio_solver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef PORTFOLIO_SOLVER_H_
+#define PORTFOLIO_SOLVER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Settings of one Solver in a portfolio.
+struct PortfolioConfig {
+  VariableSortType varSortType;
+  ValueSortType valSortType;
+  RestartPolicy restartPolicy;
+  uint64_t seed;
+};
+
+// Name of a configuration, e.g. "most_constrained/randomized/luby/seed=1".
+std::string toString(const PortfolioConfig& config);
+
+// Races several Solver configurations on a grid, one thread each. Which
+// heuristics do best varies from grid to grid, so the fastest of a few
+// tends to have a much lighter tail than any single one. The first solver
+// to finish wins (every configuration searches completely, so one running
+// out of moves proves there is no solution) and the rest are cancelled.
+class PortfolioSolver {
+public:
+  PortfolioSolver(Grid grid, std::vector<PortfolioConfig> configs,
+      PropagationLevel level = PropagationLevel::NAKED_SINGLES);
+
+  // The first numConfigs of a fixed list: the deterministic defaults, then
+  // random value orders with restarts, seeded from seed onward.
+  static std::vector<PortfolioConfig> getDefaultConfigs(int numConfigs,
+      uint64_t seed = Solver::kDefaultSeed);
+
+  const Grid& getGrid() const { return grid_; }
+  const std::vector<PortfolioConfig>& getConfigs() const { return configs_; }
+
+  // Index of the configuration that finished the last solve (-1 before the
+  // first), and the steps taken by each.
+  int getWinner() const { return winner_; }
+  const std::vector<int>& getThreadSteps() const { return threadSteps_; }
+
+  // Steps are those of the winner.
+  bool solve(Grid& solution, int& steps);
+
+private:
+  Grid grid_;
+  std::vector<PortfolioConfig> configs_;
+  PropagationLevel level_;
+  int winner_;
+  std::vector<int> threadSteps_;
+};
+
+} /* namespace sudoku */
+
+#endif /* PORTFOLIO_SOLVER_H_ */
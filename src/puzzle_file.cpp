@@ -0,0 +1,254 @@
+/*
+ * puzzle_file.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cstring>
+
+#include <src/puzzle_file.h>
+
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+const char kMagic[4] = {'S', 'D', 'K', 'B'};
+const int kStatsSize = 24;
+
+int cellBitsFor(int maxValue) {
+  if (maxValue < 1 << 4)
+    return 4;
+  if (maxValue < 1 << 8)
+    return 8;
+  return 16;
+}
+
+int packedSize(int numCells, int cellBits) {
+  return (numCells * cellBits + 7) / 8;
+}
+
+int recordSizeFor(int numCells, int cellBits, int flags) {
+  int size = packedSize(numCells, cellBits);
+  if (flags & PuzzleFile::HAS_SOLUTION)
+    size += packedSize(numCells, cellBits);
+  if (flags & PuzzleFile::HAS_STATS)
+    size += kStatsSize;
+  return size;
+}
+
+void putLittleEndian(unsigned char* out, uint64_t value, int numBytes) {
+  for (int i = 0; i < numBytes; ++i)
+    out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+uint64_t getLittleEndian(const unsigned char* in, int numBytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < numBytes; ++i)
+    value |= uint64_t(in[i]) << (8 * i);
+  return value;
+}
+
+// Packs numCells values, writing 0 for missing or unrepresentable ones.
+void pack(const vector<int>& values, int numCells, int cellBits,
+    unsigned char* out) {
+  memset(out, 0, packedSize(numCells, cellBits));
+  for (int i = 0; i < numCells && i < (int) values.size(); ++i) {
+    const int value = values[i];
+    if (value < 0 || value >= 1 << cellBits)
+      continue;
+    if (cellBits == 4)
+      out[i / 2] |= value << (4 * (i % 2));
+    else
+      putLittleEndian(out + i * (cellBits / 8), value, cellBits / 8);
+  }
+}
+
+void unpack(const unsigned char* in, int numCells, int cellBits,
+    vector<int>& values) {
+  values.resize(numCells);
+  for (int i = 0; i < numCells; ++i) {
+    if (cellBits == 4)
+      values[i] = (in[i / 2] >> (4 * (i % 2))) & 0xF;
+    else
+      values[i] = getLittleEndian(in + i * (cellBits / 8), cellBits / 8);
+  }
+}
+
+} /* namespace */
+
+bool PuzzleFile::isBinary(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (!file)
+    return false;
+  char magic[sizeof(kMagic)];
+  const bool binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic)
+      && !memcmp(magic, kMagic, sizeof(magic));
+  fclose(file);
+  return binary;
+}
+
+PuzzleFileReader::PuzzleFileReader():
+    file_(nullptr), subrows_(0), subcols_(0), flags_(0), cellBits_(0),
+    recordSize_(0), count_(0), next_(0) {
+}
+
+PuzzleFileReader::~PuzzleFileReader() {
+  close();
+}
+
+bool PuzzleFileReader::open(const char* path) {
+  close();
+  file_ = fopen(path, "rb");
+  if (!file_)
+    return false;
+
+  unsigned char header[PuzzleFile::kHeaderSize];
+  if (fread(header, 1, sizeof(header), file_) != sizeof(header)
+      || memcmp(header, kMagic, sizeof(kMagic))
+      || getLittleEndian(header + 4, 2) != PuzzleFile::kVersion) {
+    close();
+    return false;
+  }
+  flags_ = getLittleEndian(header + 6, 2);
+  subrows_ = getLittleEndian(header + 8, 2);
+  subcols_ = getLittleEndian(header + 10, 2);
+  cellBits_ = getLittleEndian(header + 12, 2);
+  recordSize_ = getLittleEndian(header + 16, 4);
+  count_ = getLittleEndian(header + 20, 8);
+
+  const int side = subrows_ * subcols_;
+  if (side == 0 || cellBits_ != cellBitsFor(side)
+      || recordSize_ != recordSizeFor(side * side, cellBits_, flags_)) {
+    close();
+    return false;
+  }
+  if (count_ == PuzzleFile::kUnknownCount) {
+    fseeko(file_, 0, SEEK_END);
+    count_ = (ftello(file_) - PuzzleFile::kHeaderSize) / recordSize_;
+    fseeko(file_, PuzzleFile::kHeaderSize, SEEK_SET);
+  }
+  buffer_.resize(recordSize_);
+  next_ = 0;
+  return true;
+}
+
+void PuzzleFileReader::close() {
+  if (file_)
+    fclose(file_);
+  file_ = nullptr;
+}
+
+bool PuzzleFileReader::read(PuzzleRecord& record) {
+  if (!file_ || next_ >= count_
+      || fread(buffer_.data(), 1, recordSize_, file_) != (size_t) recordSize_)
+    return false;
+  ++next_;
+
+  const int numCells = subrows_ * subcols_ * subrows_ * subcols_;
+  const unsigned char* in = buffer_.data();
+  unpack(in, numCells, cellBits_, record.puzzle);
+  in += packedSize(numCells, cellBits_);
+  if (flags_ & PuzzleFile::HAS_SOLUTION) {
+    unpack(in, numCells, cellBits_, record.solution);
+    in += packedSize(numCells, cellBits_);
+  } else {
+    record.solution.clear();
+  }
+  if (flags_ & PuzzleFile::HAS_STATS) {
+    record.steps = getLittleEndian(in, 8);
+    record.ns = getLittleEndian(in + 8, 8);
+    record.numSolutions = getLittleEndian(in + 16, 4);
+  } else {
+    record.steps = record.ns = record.numSolutions = 0;
+  }
+  return true;
+}
+
+bool PuzzleFileReader::seek(uint64_t n) {
+  if (!file_ || n > count_
+      || fseeko(file_, PuzzleFile::kHeaderSize + n * recordSize_, SEEK_SET))
+    return false;
+  next_ = n;
+  return true;
+}
+
+PuzzleFileWriter::PuzzleFileWriter():
+    file_(nullptr), numCells_(0), flags_(0), cellBits_(0), recordSize_(0),
+    count_(0), failed_(false) {
+}
+
+PuzzleFileWriter::~PuzzleFileWriter() {
+  close();
+}
+
+bool PuzzleFileWriter::open(const char* path, int subrows, int subcols,
+    int flags) {
+  close();
+  const int side = subrows * subcols;
+  if (side <= 0 || side > 0xFFFF || subrows > 0xFFFF || subcols > 0xFFFF)
+    return false;
+  file_ = fopen(path, "wb");
+  if (!file_)
+    return false;
+
+  numCells_ = side * side;
+  flags_ = flags;
+  cellBits_ = cellBitsFor(side);
+  recordSize_ = recordSizeFor(numCells_, cellBits_, flags_);
+  count_ = 0;
+  failed_ = false;
+  buffer_.resize(recordSize_);
+
+  unsigned char header[PuzzleFile::kHeaderSize] = {};
+  memcpy(header, kMagic, sizeof(kMagic));
+  putLittleEndian(header + 4, PuzzleFile::kVersion, 2);
+  putLittleEndian(header + 6, flags_, 2);
+  putLittleEndian(header + 8, subrows, 2);
+  putLittleEndian(header + 10, subcols, 2);
+  putLittleEndian(header + 12, cellBits_, 2);
+  putLittleEndian(header + 16, recordSize_, 4);
+  putLittleEndian(header + 20, PuzzleFile::kUnknownCount, 8);
+  failed_ = fwrite(header, 1, sizeof(header), file_) != sizeof(header);
+  return !failed_;
+}
+
+bool PuzzleFileWriter::close() {
+  if (!file_)
+    return false;
+  unsigned char count[8];
+  putLittleEndian(count, count_, sizeof(count));
+  if (!fseeko(file_, 20, SEEK_SET))
+    failed_ |= fwrite(count, 1, sizeof(count), file_) != sizeof(count);
+  failed_ |= fclose(file_) != 0;
+  file_ = nullptr;
+  return !failed_;
+}
+
+bool PuzzleFileWriter::write(const PuzzleRecord& record) {
+  if (!file_)
+    return false;
+  unsigned char* out = buffer_.data();
+  pack(record.puzzle, numCells_, cellBits_, out);
+  out += packedSize(numCells_, cellBits_);
+  if (flags_ & PuzzleFile::HAS_SOLUTION) {
+    pack(record.solution, numCells_, cellBits_, out);
+    out += packedSize(numCells_, cellBits_);
+  }
+  if (flags_ & PuzzleFile::HAS_STATS) {
+    memset(out, 0, kStatsSize);
+    putLittleEndian(out, record.steps, 8);
+    putLittleEndian(out + 8, record.ns, 8);
+    putLittleEndian(out + 16, record.numSolutions, 4);
+  }
+  if (fwrite(buffer_.data(), 1, recordSize_, file_) != (size_t) recordSize_) {
+    failed_ = true;
+    return false;
+  }
+  ++count_;
+  return true;
+}
+
+} /* namespace sudoku */
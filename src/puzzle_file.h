@@ -0,0 +1,130 @@
+/*
+ * puzzle_file.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef PUZZLE_FILE_H_
+#define PUZZLE_FILE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace sudoku {
+
+// Binary puzzle container. A 32-byte little-endian header:
+//
+//   offset  size  field
+//        0     4  magic "SDKB"
+//        4     2  version (1)
+//        6     2  flags (PuzzleFile::HAS_SOLUTION, PuzzleFile::HAS_STATS)
+//        8     2  subrows
+//       10     2  subcols
+//       12     2  bits per cell (4, 8 or 16)
+//       14     2  reserved (0)
+//       16     4  record size in bytes
+//       20     8  number of records (PuzzleFile::kUnknownCount if unknown)
+//       28     4  reserved (0)
+//
+// is followed by fixed-size records, so record N starts at byte
+// 32 + N * record size. A record is the puzzle's cells packed at the header's
+// bits per cell (low nibble first when 4 bits, little-endian when 16; 0 for
+// a blank), then the solution packed the same way if HAS_SOLUTION (all 0
+// when there is none), then if HAS_STATS the search steps and nanoseconds as
+// 64-bit integers and the number of solutions as a 32-bit integer, padded to
+// 24 bytes.
+namespace PuzzleFile {
+
+enum Flags {
+  HAS_SOLUTION = 1, HAS_STATS = 2
+};
+
+const uint16_t kVersion = 1;
+const int kHeaderSize = 32;
+const uint64_t kUnknownCount = ~uint64_t(0);
+
+// Returns true if the file starts with the binary format's magic number.
+bool isBinary(const char* path);
+
+} /* namespace PuzzleFile */
+
+struct PuzzleRecord {
+  std::vector<int> puzzle;
+  std::vector<int> solution;
+  int64_t steps = 0;
+  int64_t ns = 0;
+  int numSolutions = 0;
+};
+
+class PuzzleFileReader {
+public:
+  PuzzleFileReader();
+  ~PuzzleFileReader();
+
+  PuzzleFileReader(const PuzzleFileReader&) = delete;
+  PuzzleFileReader& operator =(const PuzzleFileReader&) = delete;
+
+  // Opens a file and reads its header; returns false if the file can't be
+  // read or isn't a supported version.
+  bool open(const char* path);
+  void close();
+
+  int getSubrows() const { return subrows_; }
+  int getSubcols() const { return subcols_; }
+  int getFlags() const { return flags_; }
+  int getCellBits() const { return cellBits_; }
+  int getRecordSize() const { return recordSize_; }
+  // Number of records, counting from the file size if the header doesn't
+  // say.
+  uint64_t size() const { return count_; }
+
+  // Reads the next record; returns false at the end of the file.
+  bool read(PuzzleRecord& record);
+  // Moves to record n.
+  bool seek(uint64_t n);
+
+private:
+  FILE* file_;
+  int subrows_, subcols_;
+  int flags_;
+  int cellBits_;
+  int recordSize_;
+  uint64_t count_;
+  uint64_t next_;
+  std::vector<unsigned char> buffer_;
+};
+
+class PuzzleFileWriter {
+public:
+  PuzzleFileWriter();
+  ~PuzzleFileWriter();
+
+  PuzzleFileWriter(const PuzzleFileWriter&) = delete;
+  PuzzleFileWriter& operator =(const PuzzleFileWriter&) = delete;
+
+  // Creates a file and writes its header, with an unknown record count
+  // until close().
+  bool open(const char* path, int subrows, int subcols, int flags);
+  // Fills in the record count if the file is seekable and closes it;
+  // returns false if any write failed.
+  bool close();
+  bool isOpen() const { return file_ != nullptr; }
+
+  bool write(const PuzzleRecord& record);
+
+private:
+  FILE* file_;
+  int numCells_;
+  int flags_;
+  int cellBits_;
+  int recordSize_;
+  uint64_t count_;
+  bool failed_;
+  std::vector<unsigned char> buffer_;
+};
+
+} /* namespace sudoku */
+
+#endif /* PUZZLE_FILE_H_ */
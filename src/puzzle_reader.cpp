@@ -0,0 +1,229 @@
+/*
+ * puzzle_reader.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <src/puzzle_reader.h>
+
+namespace sudoku {
+
+namespace {
+
+// Lines at least this long are never in the one-character-per-square format,
+// so they may be parsed in pieces rather than buffered whole.
+const std::size_t kMaxCompactLine = 256;
+
+bool isDigit(char c) {
+  return '0' <= c && c <= '9';
+}
+
+} /* namespace */
+
+PuzzleReader::PuzzleReader(std::size_t chunkSize):
+    fd_(-1), ownsFd_(false), chunkSize_(chunkSize < 1 ? 1 : chunkSize),
+    mapped_(nullptr), mappedSize_(0), data_(nullptr), begin_(0), end_(0),
+    eof_(true), pos_(nullptr), lineEnd_(nullptr), compact_(false) {
+}
+
+PuzzleReader::~PuzzleReader() {
+  close();
+}
+
+bool PuzzleReader::open(const char* path) {
+  close();
+  int fd = ::open(path, O_RDONLY);
+  if (fd == -1)
+    return false;
+  openDescriptor(fd);
+  ownsFd_ = true;
+  return true;
+}
+
+void PuzzleReader::openDescriptor(int fd) {
+  close();
+  fd_ = fd;
+  eof_ = false;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped != MAP_FAILED) {
+      madvise(mapped, st.st_size, MADV_SEQUENTIAL);
+      mapped_ = static_cast<const char*>(mapped);
+      mappedSize_ = st.st_size;
+      data_ = mapped_;
+      end_ = mappedSize_;
+      eof_ = true;
+    }
+  }
+}
+
+void PuzzleReader::close() {
+  if (mapped_)
+    munmap(const_cast<char*>(mapped_), mappedSize_);
+  if (ownsFd_ && fd_ != -1)
+    ::close(fd_);
+  fd_ = -1;
+  ownsFd_ = false;
+  mapped_ = nullptr;
+  mappedSize_ = 0;
+  data_ = nullptr;
+  begin_ = end_ = 0;
+  eof_ = true;
+  pos_ = lineEnd_ = nullptr;
+  compact_ = false;
+}
+
+int PuzzleReader::read(std::vector<int>& values, int numValues) {
+  values.resize(numValues);
+  int n = 0;
+  while (n < numValues) {
+    if (pos_ == lineEnd_ && !nextLine(numValues))
+      break;
+
+    if (compact_) {
+      for (; pos_ < lineEnd_ && n < numValues; ++pos_)
+        values[n++] = *pos_ == '.' ? 0 : *pos_ - '0';
+      continue;
+    }
+
+    while (n < numValues) {
+      while (pos_ < lineEnd_ && !isDigit(*pos_))
+        ++pos_;
+      if (pos_ == lineEnd_)
+        break;
+      int value = 0;
+      for (; pos_ < lineEnd_ && isDigit(*pos_); ++pos_) {
+        if (value < 100000000)
+          value = value * 10 + (*pos_ - '0');
+      }
+      values[n++] = value;
+    }
+  }
+  values.resize(n);
+  return n;
+}
+
+int PuzzleReader::parseLine(const char* begin, const char* end,
+    int numValues, std::vector<int>& values) {
+  values.resize(numValues);
+  int n = 0;
+  if (isCompact(begin, end, numValues)) {
+    for (; n < numValues; ++n)
+      values[n] = begin[n] == '.' ? 0 : begin[n] - '0';
+    return n;
+  }
+  for (const char* pos = begin; n < numValues; ) {
+    while (pos < end && !isDigit(*pos))
+      ++pos;
+    if (pos == end)
+      break;
+    int value = 0;
+    for (; pos < end && isDigit(*pos); ++pos) {
+      if (value < 100000000)
+        value = value * 10 + (*pos - '0');
+    }
+    values[n++] = value;
+  }
+  values.resize(n);
+  return n;
+}
+
+// Moves to the next line of input (or, for very long lines being read in
+// chunks, the next piece of one that ends between values).
+bool PuzzleReader::nextLine(int numValues) {
+  while (true) {
+    const char* begin = data_ + begin_;
+    const std::size_t length = end_ - begin_;
+    const char* newline = length > 0
+        ? static_cast<const char*>(memchr(begin, '\n', length)) : nullptr;
+
+    const char* end = newline;
+    if (!newline && eof_) {
+      if (length == 0)
+        return false;
+      end = begin + length;
+    } else if (!newline && length >= std::max(chunkSize_, kMaxCompactLine)) {
+      end = begin + length;
+      while (end > begin && isDigit(end[-1]))
+        --end;
+      if (end == begin)
+        end = nullptr;
+    }
+
+    if (end) {
+      pos_ = begin;
+      lineEnd_ = end;
+      begin_ = (newline ? newline + 1 : end) - data_;
+      compact_ = (newline || eof_) && isCompact(pos_, lineEnd_, numValues);
+      if (compact_) {
+        while (!isDigit(lineEnd_[-1]) && lineEnd_[-1] != '.')
+          --lineEnd_;
+      }
+      return true;
+    }
+    fill();
+  }
+}
+
+// Reads another chunk after the unread data. Returns false at end of input.
+bool PuzzleReader::fill() {
+  if (eof_)
+    return false;
+
+  const std::size_t remaining = end_ - begin_;
+  if (remaining > 0 && begin_ > 0)
+    memmove(buffer_.data(), buffer_.data() + begin_, remaining);
+  if (buffer_.size() < remaining + chunkSize_)
+    buffer_.resize(remaining + chunkSize_);
+  data_ = buffer_.data();
+  begin_ = 0;
+  end_ = remaining;
+
+  ssize_t n;
+  do {
+    n = ::read(fd_, buffer_.data() + end_, chunkSize_);
+  } while (n < 0 && errno == EINTR);
+  if (n <= 0) {
+    eof_ = true;
+    return false;
+  }
+  end_ += n;
+  return true;
+}
+
+// A line is in the one-character-per-square format if, ignoring trailing
+// whitespace, it is exactly one grid of digits and dots. Lines where single
+// digits and dots strictly alternate are values separated by dots instead.
+bool PuzzleReader::isCompact(const char* begin, const char* end,
+    int numValues) {
+  if (numValues > 81)
+    return false;
+  while (end > begin && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+    --end;
+  if (end - begin != numValues)
+    return false;
+
+  bool alternating = true;
+  bool hasDot = false;
+  for (const char* c = begin; c < end; ++c) {
+    if (!isDigit(*c) && *c != '.')
+      return false;
+    hasDot |= *c == '.';
+    alternating &= isDigit(*c) == ((c - begin) % 2 == 0);
+  }
+  return !(hasDot && alternating);
+}
+
+} /* namespace sudoku */
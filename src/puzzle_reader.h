@@ -0,0 +1,70 @@
+/*
+ * puzzle_reader.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef PUZZLE_READER_H_
+#define PUZZLE_READER_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace sudoku {
+
+// Reads grid definitions from a file or descriptor. Files are memory-mapped
+// when possible; pipes and terminals are read in large chunks. Two formats
+// are accepted, and may be mixed:
+//  - values as decimal numbers separated by any non-numeric characters,
+//    with 0 for a blank square;
+//  - one grid per line, one character per square ('1'-'9', with '0' or '.'
+//    for a blank), for grids with at most 9 values.
+class PuzzleReader {
+public:
+  explicit PuzzleReader(std::size_t chunkSize = 1 << 20);
+  ~PuzzleReader();
+
+  PuzzleReader(const PuzzleReader&) = delete;
+  PuzzleReader& operator =(const PuzzleReader&) = delete;
+
+  bool open(const char* path);
+  void openDescriptor(int fd);
+  void close();
+  bool isOpen() const { return fd_ != -1; }
+
+  // Reads the next numValues values; returns how many were read, which is
+  // less than numValues only at the end of the input.
+  int read(std::vector<int>& values, int numValues);
+
+  // Parses up to numValues values from one line, in either format; returns
+  // how many were parsed.
+  static int parseLine(const char* begin, const char* end, int numValues,
+      std::vector<int>& values);
+
+private:
+  int fd_;
+  bool ownsFd_;
+  std::size_t chunkSize_;
+
+  // Mapped file contents, or chunks read so far.
+  const char* mapped_;
+  std::size_t mappedSize_;
+  std::vector<char> buffer_;
+  const char* data_;
+  std::size_t begin_, end_;
+  bool eof_;
+
+  // Unread part of the current line.
+  const char* pos_;
+  const char* lineEnd_;
+  bool compact_;
+
+  bool nextLine(int numValues);
+  bool fill();
+  static bool isCompact(const char* begin, const char* end, int numValues);
+};
+
+} /* namespace sudoku */
+
+#endif /* PUZZLE_READER_H_ */
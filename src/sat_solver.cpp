@@ -0,0 +1,503 @@
+/*
+ * sat_solver.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <src/sat_solver.h>
+#include <src/solver.h>
+
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+const int kHeaderSize = 3;
+const int kLearnt = 1;
+const int kDeleted = 2;
+
+const double kVarDecay = 0.95;
+const double kClauseDecay = 0.999;
+const int kRestartBase = 100;
+
+} /* namespace */
+
+SatSolver::SatSolver(Grid grid):
+    grid_(grid), status_(SolveStatus::UNSOLVABLE), numVars_(0), wasted_(0), propagated_(0), varIncrement_(1),
+    clauseIncrement_(1), numConflicts_(0), maxLearnts_(0) {
+}
+
+bool SatSolver::solve(Grid& solution, int& steps) {
+  steps = 0;
+  numConflicts_ = 0;
+  status_ = SolveStatus::UNSOLVABLE;
+  if (!build())
+    return false;
+
+  limitCheck_.start(limits_);
+  int status = 0;
+  for (int run = 0; status == 0 && !limitCheck_.isAborted(); ++run) {
+    status = search(Solver::getRestartBudget(RestartPolicy::LUBY,
+        kRestartBase, run), steps);
+    maxLearnts_ *= 1.1;
+  }
+  if (status <= 0) {
+    if (status == 0)
+      status_ = SolveStatus::ABORTED;
+    return false;
+  }
+  status_ = SolveStatus::SOLVED;
+
+  solution = grid_;
+  for (int var = 0; var < numVars_; ++var) {
+    if (assigns_[var] > 0)
+      solution[varIndices_[var]].setOnly(varValues_[var]);
+  }
+  solution.clearTrail();
+  return true;
+}
+
+// Encodes the grid. Returns false if that alone shows there is no solution.
+bool SatSolver::build() {
+  const int side = grid_.getMaxValue();
+  vector<int> vars(grid_.size() * side, -1);
+  varIndices_.clear();
+  varValues_.clear();
+  for (int i = 0; i < grid_.size(); ++i) {
+    for (auto value : grid_.getValues(i)) {
+      vars[i * side + value - 1] = varIndices_.size();
+      varIndices_.push_back(i);
+      varValues_.push_back(value);
+    }
+  }
+  numVars_ = varIndices_.size();
+
+  arena_.clear();
+  clauses_.clear();
+  learnts_.clear();
+  wasted_ = 0;
+  watches_.assign(2 * numVars_, vector<Watcher>());
+  assigns_.assign(numVars_, 0);
+  phases_.assign(numVars_, 0);
+  levels_.assign(numVars_, 0);
+  reasons_.assign(numVars_, -1);
+  trail_.clear();
+  trailLimits_.clear();
+  propagated_ = 0;
+  activities_.assign(numVars_, 0);
+  varIncrement_ = 1;
+  clauseIncrement_ = 1;
+  heap_.clear();
+  heapIndices_.assign(numVars_, -1);
+  for (int var = 0; var < numVars_; ++var)
+    heapInsert(var);
+  seen_.assign(numVars_, 0);
+
+  // Exactly one of each group of variables is true.
+  bool ok = true;
+  vector<int> group, pair(2);
+  auto addExactlyOne = [&]() {
+    if (group.empty()) {
+      ok = false;
+      return;
+    }
+    for (auto& var : group)
+      var = 2 * var;
+    if (addClause(group, false) == -1)
+      ok = false;
+    for (int a = 0; a < (signed) group.size(); ++a) {
+      for (int b = a + 1; b < (signed) group.size(); ++b) {
+        pair[0] = group[a] ^ 1;
+        pair[1] = group[b] ^ 1;
+        addClause(pair, false);
+      }
+    }
+  };
+  for (int i = 0; i < grid_.size() && ok; ++i) {
+    group.clear();
+    for (int value = 1; value <= side; ++value) {
+      if (vars[i * side + value - 1] != -1)
+        group.push_back(vars[i * side + value - 1]);
+    }
+    addExactlyOne();
+  }
+  for (int unit = 0; unit < grid_.getNumUnits() && ok; ++unit) {
+    for (int value = 1; value <= side && ok; ++value) {
+      group.clear();
+      for (auto i : grid_.getUnit(unit)) {
+        if (vars[i * side + value - 1] != -1)
+          group.push_back(vars[i * side + value - 1]);
+      }
+      addExactlyOne();
+    }
+  }
+  maxLearnts_ = std::max<double>(clauses_.size() / 3, 1000);
+  return ok && propagate() == -1;
+}
+
+// Adds and watches a clause, except for unit clauses, which are assigned at
+// the current level instead. Returns the clause, or -1 for a unit clause
+// that contradicts the current assignment.
+int SatSolver::addClause(const vector<int>& lits, bool learnt) {
+  if (lits.size() == 1) {
+    if (getValue(lits[0]) < 0)
+      return -1;
+    if (getValue(lits[0]) == 0)
+      enqueue(lits[0], -1);
+    return 0;
+  }
+  const int clause = arena_.size();
+  arena_.push_back(lits.size());
+  arena_.push_back(learnt ? kLearnt : 0);
+  arena_.push_back(0);
+  arena_.insert(arena_.end(), lits.begin(), lits.end());
+  setActivity(clause, 0);
+  (learnt ? learnts_ : clauses_).push_back(clause);
+  attach(clause);
+  return clause;
+}
+
+void SatSolver::attach(int clause) {
+  const int* lits = getLits(clause);
+  watches_[lits[0]].push_back({ clause, lits[1] });
+  watches_[lits[1]].push_back({ clause, lits[0] });
+}
+
+float SatSolver::getActivity(int clause) const {
+  float activity;
+  memcpy(&activity, &arena_[clause + 2], sizeof(activity));
+  return activity;
+}
+
+void SatSolver::setActivity(int clause, float activity) {
+  memcpy(&arena_[clause + 2], &activity, sizeof(activity));
+}
+
+// 1 if the literal is true, -1 if false, 0 if unassigned.
+int SatSolver::getValue(int lit) const {
+  const int value = assigns_[lit >> 1];
+  return lit & 1 ? -value : value;
+}
+
+void SatSolver::enqueue(int lit, int reason) {
+  const int var = lit >> 1;
+  assigns_[var] = lit & 1 ? -1 : 1;
+  levels_[var] = getLevel();
+  reasons_[var] = reason;
+  trail_.push_back(lit);
+}
+
+// Returns a conflicting clause, or -1 if there is none. A clause is watched
+// by its first two literals; when one becomes false, another literal that
+// isn't false takes its place, and if there is none the clause propagates
+// its other watch. Implied literals are moved to the front of their reason.
+int SatSolver::propagate() {
+  while (propagated_ < (signed) trail_.size()) {
+    const int falseLit = trail_[propagated_++] ^ 1;
+    vector<Watcher>& watchers = watches_[falseLit];
+    int i = 0, j = 0;
+    const int n = watchers.size();
+    while (i < n) {
+      const Watcher watcher = watchers[i++];
+      if (getValue(watcher.blocker) > 0) {
+        watchers[j++] = watcher;
+        continue;
+      }
+      if (isDeleted(watcher.clause))
+        continue;
+      int* lits = getLits(watcher.clause);
+      if (lits[0] == falseLit)
+        std::swap(lits[0], lits[1]);
+      const int first = lits[0];
+      if (first != watcher.blocker && getValue(first) > 0) {
+        watchers[j++] = { watcher.clause, first };
+        continue;
+      }
+
+      const int size = getSize(watcher.clause);
+      bool moved = false;
+      for (int k = 2; k < size; ++k) {
+        if (getValue(lits[k]) >= 0) {
+          std::swap(lits[1], lits[k]);
+          watches_[lits[1]].push_back({ watcher.clause, first });
+          moved = true;
+          break;
+        }
+      }
+      if (moved)
+        continue;
+
+      watchers[j++] = { watcher.clause, first };
+      if (getValue(first) < 0) {
+        while (i < n)
+          watchers[j++] = watchers[i++];
+        watchers.resize(j);
+        propagated_ = trail_.size();
+        return watcher.clause;
+      }
+      enqueue(first, watcher.clause);
+    }
+    watchers.resize(j);
+  }
+  return -1;
+}
+
+// Derives the first-UIP clause of a conflict into learnt_, with the
+// asserting literal first and a literal of the backjump level second, and
+// returns the backjump level.
+int SatSolver::analyze(int conflict) {
+  learnt_.assign(1, -1);
+  int pathCount = 0;
+  int lit = -1;
+  int index = trail_.size() - 1;
+  do {
+    if (isLearnt(conflict))
+      bumpClause(conflict);
+    const int* lits = getLits(conflict);
+    for (int j = lit == -1 ? 0 : 1; j < getSize(conflict); ++j) {
+      const int var = lits[j] >> 1;
+      if (seen_[var] || levels_[var] == 0)
+        continue;
+      bumpVar(var);
+      seen_[var] = 1;
+      if (levels_[var] >= getLevel())
+        pathCount++;
+      else
+        learnt_.push_back(lits[j]);
+    }
+    while (!seen_[trail_[index--] >> 1])
+      ;
+    lit = trail_[index + 1];
+    conflict = reasons_[lit >> 1];
+    seen_[lit >> 1] = 0;
+    pathCount--;
+  } while (pathCount > 0);
+  learnt_[0] = lit ^ 1;
+
+  // Drops literals implied by the others (all of their reason's other
+  // literals are in the clause already).
+  const vector<int> lits(learnt_);
+  int size = 1;
+  for (int i = 1; i < (signed) lits.size(); ++i) {
+    const int reason = reasons_[lits[i] >> 1];
+    bool redundant = reason != -1;
+    for (int k = 1; redundant && k < getSize(reason); ++k) {
+      const int var = getLits(reason)[k] >> 1;
+      redundant = seen_[var] || levels_[var] == 0;
+    }
+    if (!redundant)
+      learnt_[size++] = lits[i];
+  }
+  learnt_.resize(size);
+  for (auto& l : lits)
+    seen_[l >> 1] = 0;
+
+  if (learnt_.size() == 1)
+    return 0;
+  int maxIndex = 1;
+  for (int i = 2; i < (signed) learnt_.size(); ++i) {
+    if (levels_[learnt_[i] >> 1] > levels_[learnt_[maxIndex] >> 1])
+      maxIndex = i;
+  }
+  std::swap(learnt_[1], learnt_[maxIndex]);
+  return levels_[learnt_[1] >> 1];
+}
+
+void SatSolver::cancelUntil(int level) {
+  if (getLevel() <= level)
+    return;
+  for (int i = trail_.size() - 1; i >= trailLimits_[level]; --i) {
+    const int var = trail_[i] >> 1;
+    assigns_[var] = 0;
+    reasons_[var] = -1;
+    phases_[var] = trail_[i] & 1;
+    if (heapIndices_[var] == -1)
+      heapInsert(var);
+  }
+  trail_.resize(trailLimits_[level]);
+  trailLimits_.resize(level);
+  propagated_ = trail_.size();
+}
+
+// The unassigned variable with the highest activity, in its last phase
+// (initially true, which places a value), or -1 if all are assigned.
+int SatSolver::pickBranchLit() {
+  while (!heap_.empty()) {
+    const int var = heapPop();
+    if (assigns_[var] == 0)
+      return 2 * var + phases_[var];
+  }
+  return -1;
+}
+
+// Returns 1 if a solution was found, -1 if there is none, and 0 if the
+// search was restarted after maxConflicts conflicts or reached the limits.
+int SatSolver::search(long long maxConflicts, int& steps) {
+  long long conflicts = 0;
+  for (;;) {
+    const int conflict = propagate();
+    if (conflict != -1) {
+      numConflicts_++;
+      conflicts++;
+      if (getLevel() == 0)
+        return -1;
+      cancelUntil(analyze(conflict));
+      if (learnt_.size() == 1) {
+        enqueue(learnt_[0], -1);
+      } else {
+        const int clause = addClause(learnt_, true);
+        bumpClause(clause);
+        enqueue(learnt_[0], clause);
+      }
+      varIncrement_ /= kVarDecay;
+      clauseIncrement_ /= kClauseDecay;
+      continue;
+    }
+
+    if (conflicts >= maxConflicts) {
+      cancelUntil(0);
+      return 0;
+    }
+    if ((signed) learnts_.size() - (signed) trail_.size() >= maxLearnts_)
+      reduceLearnts();
+    const int lit = pickBranchLit();
+    if (lit == -1)
+      return 1;
+    if (limitCheck_(steps))
+      return 0;
+    steps++;
+    trailLimits_.push_back(trail_.size());
+    enqueue(lit, -1);
+  }
+}
+
+void SatSolver::bumpVar(int var) {
+  activities_[var] += varIncrement_;
+  if (activities_[var] > 1e100) {
+    for (auto& activity : activities_)
+      activity *= 1e-100;
+    varIncrement_ *= 1e-100;
+  }
+  if (heapIndices_[var] != -1)
+    heapUp(heapIndices_[var]);
+}
+
+void SatSolver::bumpClause(int clause) {
+  setActivity(clause, getActivity(clause) + clauseIncrement_);
+  if (getActivity(clause) > 1e20) {
+    for (auto& learnt : learnts_)
+      setActivity(learnt, getActivity(learnt) * 1e-20);
+    clauseIncrement_ *= 1e-20;
+  }
+}
+
+// Deletes the less active half of the learnt clauses, except binary ones
+// and reasons of current assignments.
+void SatSolver::reduceLearnts() {
+  std::sort(learnts_.begin(), learnts_.end(), [&](int a, int b) {
+    return getActivity(a) < getActivity(b);
+  });
+  int size = 0;
+  for (int i = 0; i < (signed) learnts_.size(); ++i) {
+    const int clause = learnts_[i];
+    if (i < (signed) learnts_.size() / 2 && getSize(clause) > 2
+        && !isLocked(clause)) {
+      arena_[clause + 1] |= kDeleted;
+      wasted_ += kHeaderSize + getSize(clause);
+    } else {
+      learnts_[size++] = clause;
+    }
+  }
+  learnts_.resize(size);
+  if (wasted_ > (signed) arena_.size() / 2)
+    collectGarbage();
+}
+
+bool SatSolver::isLocked(int clause) const {
+  const int lit = getLits(clause)[0];
+  return reasons_[lit >> 1] == clause && getValue(lit) > 0;
+}
+
+// Compacts the arena, leaving the new offset of each live clause in its old
+// activity slot to update the clause lists and reasons, then rewatches.
+void SatSolver::collectGarbage() {
+  vector<int> arena;
+  arena.reserve(arena_.size() - wasted_);
+  for (auto* list : { &clauses_, &learnts_ }) {
+    for (auto& clause : *list) {
+      const int moved = arena.size();
+      arena.insert(arena.end(), arena_.begin() + clause,
+          arena_.begin() + clause + kHeaderSize + getSize(clause));
+      arena_[clause + 2] = moved;
+      clause = moved;
+    }
+  }
+  for (auto& lit : trail_) {
+    int& reason = reasons_[lit >> 1];
+    if (reason != -1)
+      reason = arena_[reason + 2];
+  }
+  arena_.swap(arena);
+  wasted_ = 0;
+
+  for (auto& watchers : watches_)
+    watchers.clear();
+  for (auto* list : { &clauses_, &learnts_ }) {
+    for (auto& clause : *list)
+      attach(clause);
+  }
+}
+
+bool SatSolver::heapLess(int a, int b) const {
+  return activities_[a] > activities_[b];
+}
+
+void SatSolver::heapUp(int i) {
+  const int var = heap_[i];
+  while (i > 0 && heapLess(var, heap_[(i - 1) / 2])) {
+    heap_[i] = heap_[(i - 1) / 2];
+    heapIndices_[heap_[i]] = i;
+    i = (i - 1) / 2;
+  }
+  heap_[i] = var;
+  heapIndices_[var] = i;
+}
+
+void SatSolver::heapDown(int i) {
+  const int var = heap_[i];
+  const int n = heap_.size();
+  while (2 * i + 1 < n) {
+    int child = 2 * i + 1;
+    if (child + 1 < n && heapLess(heap_[child + 1], heap_[child]))
+      child++;
+    if (!heapLess(heap_[child], var))
+      break;
+    heap_[i] = heap_[child];
+    heapIndices_[heap_[i]] = i;
+    i = child;
+  }
+  heap_[i] = var;
+  heapIndices_[var] = i;
+}
+
+void SatSolver::heapInsert(int var) {
+  heap_.push_back(var);
+  heapUp(heap_.size() - 1);
+}
+
+int SatSolver::heapPop() {
+  const int var = heap_[0];
+  heapIndices_[var] = -1;
+  heap_[0] = heap_.back();
+  heap_.pop_back();
+  if (!heap_.empty())
+    heapDown(0);
+  return var;
+}
+
+} /* namespace sudoku */
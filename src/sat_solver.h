@@ -0,0 +1,115 @@
+/*
+ * sat_solver.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SAT_SOLVER_H_
+#define SAT_SOLVER_H_
+
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Solves a grid as a boolean satisfiability problem with conflict-driven
+// clause learning. Each (cell, value) candidate of the grid is a variable;
+// clauses require exactly one value per cell and, in each unit, exactly one
+// cell per value (an at-least-one clause plus pairwise at-most-one clauses).
+// The search propagates with two watched literals, branches on the most
+// active variable (VSIDS), learns the first-UIP clause of each conflict and
+// backjumps to where that clause propagates, restarting on the Luby
+// sequence. Learning pays off on large grids, where chronological
+// backtracking keeps running into the same conflicts.
+class SatSolver {
+public:
+  explicit SatSolver(Grid grid);
+
+  const Grid& getGrid() const { return grid_; }
+
+  // Checked as in Solver before each decision. None by default.
+  const SolveLimits& getLimits() const { return limits_; }
+  void setLimits(const SolveLimits& limits) { limits_ = limits; }
+  SolveStatus getStatus() const { return status_; }
+
+  // Steps are decisions.
+  bool solve(Grid& solution, int& steps);
+
+  // Conflicts met in the last solve.
+  long long getNumConflicts() const { return numConflicts_; }
+
+private:
+  // Literal 2v is variable v true, 2v + 1 is v false.
+  struct Watcher {
+    int clause;
+    int blocker;  // Another literal of the clause; if true, skip the clause.
+  };
+
+  Grid grid_;
+  SolveLimits limits_;
+  LimitCheck limitCheck_;
+  SolveStatus status_;
+  int numVars_;
+  std::vector<int> varIndices_, varValues_;
+
+  // Clauses live in one arena, each a header (size, flags, activity)
+  // followed by its literals, and are referred to by offset.
+  std::vector<int> arena_;
+  std::vector<int> clauses_, learnts_;
+  int wasted_;  // Size of deleted clauses still in the arena.
+  std::vector<std::vector<Watcher>> watches_;
+
+  std::vector<signed char> assigns_;
+  std::vector<signed char> phases_;
+  std::vector<int> levels_, reasons_;
+  std::vector<int> trail_, trailLimits_;
+  int propagated_;
+
+  std::vector<double> activities_;
+  double varIncrement_, clauseIncrement_;
+  std::vector<int> heap_, heapIndices_;
+
+  std::vector<char> seen_;
+  std::vector<int> learnt_;
+  long long numConflicts_;
+  double maxLearnts_;
+
+  bool build();
+  int addClause(const std::vector<int>& lits, bool learnt);
+  void attach(int clause);
+  int* getLits(int clause) { return &arena_[clause + 3]; }
+  const int* getLits(int clause) const { return &arena_[clause + 3]; }
+  int getSize(int clause) const { return arena_[clause]; }
+  bool isLearnt(int clause) const { return arena_[clause + 1] & 1; }
+  bool isDeleted(int clause) const { return arena_[clause + 1] & 2; }
+  float getActivity(int clause) const;
+  void setActivity(int clause, float activity);
+
+  int getValue(int lit) const;
+  int getLevel() const { return trailLimits_.size(); }
+  void enqueue(int lit, int reason);
+  int propagate();
+  int analyze(int conflict);
+  void cancelUntil(int level);
+  int pickBranchLit();
+  int search(long long maxConflicts, int& steps);
+
+  void bumpVar(int var);
+  void bumpClause(int clause);
+  void reduceLearnts();
+  bool isLocked(int clause) const;
+  void collectGarbage();
+
+  bool heapLess(int a, int b) const;
+  void heapUp(int i);
+  void heapDown(int i);
+  void heapInsert(int var);
+  int heapPop();
+};
+
+} /* namespace sudoku */
+
+#endif /* SAT_SOLVER_H_ */
@@ -0,0 +1,216 @@
+/*
+ * server.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <src/server.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+namespace {
+
+const std::size_t kReadSize = 1 << 16;
+
+bool isBlank(const char* begin, const char* end) {
+  for (; begin < end; ++begin) {
+    if (*begin != ' ' && *begin != '\t' && *begin != '\r')
+      return false;
+  }
+  return true;
+}
+
+bool writeAll(int fd, const string& data) {
+  for (std::size_t written = 0; written < data.size(); ) {
+    const ssize_t n = write(fd, data.data() + written, data.size() - written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    written += n;
+  }
+  return true;
+}
+
+} /* namespace */
+
+Server::Server(const Handler& handler, int numThreads):
+    handler_(handler), closing_(false), stopped_(false), listenFd_(-1) {
+  // The thread reading a batch handles requests too.
+  for (int i = 1; i < numThreads; ++i)
+    workers_.emplace_back(&Server::work, this);
+}
+
+Server::~Server() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+    jobAdded_.notify_all();
+  }
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+bool Server::serve(int inFd, int outFd) {
+  vector<char> buffer(kReadSize);
+  string pending, output;
+  vector<string> requests, responses;
+  while (true) {
+    const ssize_t n = read(inFd, buffer.data(), buffer.size());
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n < 0)
+      return false;
+
+    // At the end of the input, a last line without a newline still counts.
+    if (n == 0)
+      pending += '\n';
+    else
+      pending.append(buffer.data(), n);
+    requests.clear();
+    std::size_t begin = 0;
+    for (std::size_t end; (end = pending.find('\n', begin)) != string::npos;
+        begin = end + 1) {
+      if (!isBlank(&pending[begin], &pending[end]))
+        requests.emplace_back(pending, begin, end - begin);
+    }
+    pending.erase(0, begin);
+
+    if (!requests.empty()) {
+      handleBatch(requests, responses);
+      output.clear();
+      for (auto& response : responses) {
+        output += response;
+        output += '\n';
+      }
+      if (!writeAll(outFd, output))
+        return false;
+    }
+    if (n == 0)
+      return true;
+  }
+}
+
+bool Server::listen(const string& path) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+    return false;
+  memcpy(address.sun_path, path.c_str(), path.size());
+
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1)
+    return false;
+  unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+      || ::listen(fd, SOMAXCONN) != 0) {
+    close(fd);
+    return false;
+  }
+  // Clients that hang up early would otherwise kill the process when their
+  // responses are written.
+  signal(SIGPIPE, SIG_IGN);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listenFd_ = fd;
+  }
+
+  while (!stopped_) {
+    const int connection = accept(fd, nullptr, nullptr);
+    if (connection == -1) {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+      break;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopped_) {
+      close(connection);
+      break;
+    }
+    connections_.insert(connection);
+    std::thread(&Server::serveConnection, this, connection).detach();
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  connectionClosed_.wait(lock, [&] { return connections_.empty(); });
+  listenFd_ = -1;
+  close(fd);
+  unlink(path.c_str());
+  return true;
+}
+
+void Server::stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stopped_ = true;
+  // Shutting down wakes a thread blocked in accept or read.
+  if (listenFd_ != -1)
+    shutdown(listenFd_, SHUT_RDWR);
+  for (auto& connection : connections_)
+    shutdown(connection, SHUT_RD);
+}
+
+void Server::work() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      jobAdded_.wait(lock, [&] { return closing_ || !jobs_.empty(); });
+      if (jobs_.empty())
+        return;
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+void Server::handleBatch(const vector<string>& requests,
+    vector<string>& responses) {
+  responses.resize(requests.size());
+  if (requests.size() == 1 || workers_.empty()) {
+    for (int i = 0; i < (signed) requests.size(); ++i)
+      responses[i] = handler_(requests[i]);
+    return;
+  }
+
+  Batch batch;
+  batch.pending = requests.size() - 1;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 1; i < (signed) requests.size(); ++i) {
+      jobs_.push_back([&, i] {
+        responses[i] = handler_(requests[i]);
+        std::lock_guard<std::mutex> batchLock(batch.mutex);
+        if (--batch.pending == 0)
+          batch.done.notify_one();
+      });
+    }
+    jobAdded_.notify_all();
+  }
+  responses[0] = handler_(requests[0]);
+  std::unique_lock<std::mutex> lock(batch.mutex);
+  batch.done.wait(lock, [&] { return batch.pending == 0; });
+}
+
+void Server::serveConnection(int fd) {
+  serve(fd, fd);
+  std::lock_guard<std::mutex> lock(mutex_);
+  connections_.erase(fd);
+  close(fd);
+  connectionClosed_.notify_all();
+}
+
+} /* namespace sudoku */
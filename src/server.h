@@ -0,0 +1,86 @@
+/*
+ * server.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SERVER_H_
+#define SERVER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sudoku {
+
+// Answers requests over a line protocol, on a file descriptor pair (such as
+// stdin and stdout) or on the connections of a Unix domain socket. Each
+// non-blank request line gets one response line, in request order. Lines
+// that arrive together (in one read) are handled as a batch: its requests
+// are spread over a pool of worker threads that lives as long as the
+// server, and its responses are written together. A batch of one request
+// is handled on the connection's own thread, which keeps single requests
+// from waiting on a thread handoff.
+class Server {
+public:
+  // Turns a request line (without its newline) into a response line.
+  // Called on several threads at once.
+  typedef std::function<std::string(const std::string& request)> Handler;
+
+  Server(const Handler& handler, int numThreads);
+  ~Server();
+
+  Server(const Server&) = delete;
+  Server& operator =(const Server&) = delete;
+
+  int getNumThreads() const { return workers_.size() + 1; }
+
+  // Serves requests read from inFd until its end. Returns false if reading
+  // or writing failed.
+  bool serve(int inFd, int outFd);
+
+  // Serves each connection to a socket at path (replacing any file there)
+  // on its own thread, until stop() is called. Returns false if the socket
+  // couldn't be created.
+  bool listen(const std::string& path);
+  // Stops listen() from accepting connections and ends the connections it
+  // is serving once their current batch is answered. Safe to call from any
+  // thread, before or during listen().
+  void stop();
+
+private:
+  struct Batch {
+    std::mutex mutex;
+    std::condition_variable done;
+    int pending;
+  };
+
+  Handler handler_;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable jobAdded_;
+  std::deque<std::function<void()>> jobs_;
+  bool closing_;
+
+  // Guarded by mutex_, like the jobs.
+  std::atomic<bool> stopped_;
+  int listenFd_;
+  std::set<int> connections_;
+  std::condition_variable connectionClosed_;
+
+  void work();
+  void handleBatch(const std::vector<std::string>& requests,
+      std::vector<std::string>& responses);
+  void serveConnection(int fd);
+};
+
+} /* namespace sudoku */
+
+#endif /* SERVER_H_ */
@@ -0,0 +1,107 @@
+/*
+ * solution_cache.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <chrono>
+
+#include <src/canonicalizer.h>
+#include <src/solution_cache.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+SolutionCache::SolutionCache(int capacity):
+    capacity_(capacity < 1 ? 1 : capacity), hits_(0), misses_(0),
+    canonicalizationNs_(0) {
+}
+
+int SolutionCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+SolveStatus SolutionCache::solve(const Grid& grid, Grid& solution, int& steps,
+    const SolveFunction& solve, SolveStats* stats) {
+  // Propagation alone solved the grid (as it does most easy puzzles), so
+  // there's no search to save and canonicalizing would cost more.
+  bool filled = true;
+  for (int i = 0; i < grid.size() && filled; ++i)
+    filled = grid.getValues(i).size() == 1;
+  if (filled)
+    return solve(grid, solution, steps);
+
+  auto begin = std::chrono::steady_clock::now();
+  GridTransform transform;
+  // Grids of different dimensions can have forms of the same length.
+  const string key = std::to_string(grid.getSubrows()) + "x"
+      + std::to_string(grid.getSubcols()) + ":"
+      + Canonicalizer(grid.getSubrows(), grid.getSubcols())
+          .canonicalize(grid, transform);
+  const long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - begin).count();
+  canonicalizationNs_ += ns;
+  SUDOKU_STATS_ADD(stats, canonicalizationNs, ns);
+
+  bool found = false, solved = false;
+  vector<int> values;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = index_.find(key);
+    if (entry != index_.end()) {
+      entries_.splice(entries_.begin(), entries_, entry->second);
+      found = true;
+      solved = entry->second->solved;
+      values = entry->second->solution;
+    }
+  }
+  if (found) {
+    hits_++;
+    SUDOKU_STATS_ADD(stats, cacheHits, 1);
+    steps = 0;
+    if (!solved)
+      return SolveStatus::UNSOLVABLE;
+    solution = Grid(grid.getSubrows(), grid.getSubcols(),
+        transform.invert(values));
+    return SolveStatus::SOLVED;
+  }
+
+  misses_++;
+  SUDOKU_STATS_ADD(stats, cacheMisses, 1);
+  const SolveStatus status = solve(grid, solution, steps);
+  if (status == SolveStatus::ABORTED)
+    return status;
+  solved = status == SolveStatus::SOLVED;
+  if (solved) {
+    values.resize(solution.size());
+    for (int i = 0; i < solution.size(); ++i)
+      values[i] = solution.getValues(i).front();
+    values = transform.apply(values);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index_.count(key))
+    return status;
+  entries_.push_front({ key, solved, values });
+  index_[key] = entries_.begin();
+  if ((signed) entries_.size() > capacity_) {
+    index_.erase(entries_.back().key);
+    entries_.pop_back();
+  }
+  return status;
+}
+
+SolveStatus SolutionCache::solve(Solver& solver, Grid& solution, int& steps,
+    SolveStats* stats) {
+  return solve(solver.getGrid(), solution, steps,
+      [&](const Grid&, Grid& result, int& resultSteps) {
+    solver.solve(result, resultSteps);
+    return solver.getStatus();
+  }, stats);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,75 @@
+/*
+ * solution_cache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SOLUTION_CACHE_H_
+#define SOLUTION_CACHE_H_
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solve_stats.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Results of recently solved puzzles, keyed by canonical form (see
+// Canonicalizer), so that a puzzle equivalent to one already solved is
+// answered by mapping that solution back through the puzzle's transform.
+// Holds at most a fixed number of results, evicting the least recently
+// used. Safe to share between threads; two threads missing on the same
+// puzzle both solve it.
+class SolutionCache {
+public:
+  // Solves grid like Solver::solve, returning the status of the solve.
+  typedef std::function<SolveStatus(const Grid& grid, Grid& solution,
+      int& steps)> SolveFunction;
+
+  explicit SolutionCache(int capacity);
+
+  int getCapacity() const { return capacity_; }
+  int size() const;
+
+  // Returns the grid's result from the cache, or solves it with solve and
+  // caches the result; steps are 0 on a hit. Aborted solves aren't cached,
+  // and grids propagation already filled bypass the cache. A non-null stats
+  // records the hit or miss and the time spent canonicalizing.
+  SolveStatus solve(const Grid& grid, Grid& solution, int& steps,
+      const SolveFunction& solve, SolveStats* stats = nullptr);
+  // Solves the solver's grid with the solver (and its limits) on a miss.
+  SolveStatus solve(Solver& solver, Grid& solution, int& steps,
+      SolveStats* stats = nullptr);
+
+  // Totals over every lookup so far.
+  long long getHits() const { return hits_; }
+  long long getMisses() const { return misses_; }
+  long long getCanonicalizationNs() const { return canonicalizationNs_; }
+
+private:
+  struct Entry {
+    std::string key;
+    bool solved;
+    std::vector<int> solution;  // in canonical form
+  };
+
+  int capacity_;
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+
+  std::atomic<long long> hits_, misses_, canonicalizationNs_;
+};
+
+} /* namespace sudoku */
+
+#endif /* SOLUTION_CACHE_H_ */
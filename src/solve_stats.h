@@ -0,0 +1,101 @@
+/*
+ * solve_stats.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SOLVE_STATS_H_
+#define SOLVE_STATS_H_
+
+#include <chrono>
+#include <vector>
+
+// Build with SUDOKU_STATS=0 to compile the search instrumentation out
+// entirely; the counters then stay zero.
+#ifndef SUDOKU_STATS
+#define SUDOKU_STATS 1
+#endif
+
+namespace sudoku {
+
+// Counters from one search, filled in by solvers that collect them.
+struct SolveStats {
+  static const bool kEnabled = SUDOKU_STATS;
+
+  long long assignments = 0;   // values tried at search nodes
+  long long eliminations = 0;  // candidates removed, including by propagation
+  long long propagations = 0;  // cells whose value was propagated to peers
+  long long deadEnds = 0;      // assignments refuted by propagation
+  long long backtracks = 0;    // assignments undone
+  long long restarts = 0;
+  int maxDepth = 0;
+  // Number of search nodes at each depth (the root is depth 0).
+  std::vector<long long> depthNodes;
+
+  long long propagationNs = 0;
+  long long selectionNs = 0;
+  long long orderingNs = 0;
+
+  // Lookups in a SolutionCache, and the time spent canonicalizing for them.
+  long long cacheHits = 0;
+  long long cacheMisses = 0;
+  long long canonicalizationNs = 0;
+
+  void clear() { *this = SolveStats(); }
+
+  void addNode(int depth) {
+    if (depth >= (signed) depthNodes.size())
+      depthNodes.resize(depth + 1);
+    depthNodes[depth]++;
+    if (depth > maxDepth)
+      maxDepth = depth;
+  }
+};
+
+#if SUDOKU_STATS
+
+// Adds the time until the end of the scope to *ns, unless ns is null.
+class ScopedStatsTimer {
+public:
+  explicit ScopedStatsTimer(long long* ns): ns_(ns) {
+    if (ns_)
+      begin_ = std::chrono::steady_clock::now();
+  }
+  ~ScopedStatsTimer() {
+    if (ns_) {
+      *ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - begin_).count();
+    }
+  }
+
+  ScopedStatsTimer(const ScopedStatsTimer&) = delete;
+  ScopedStatsTimer& operator =(const ScopedStatsTimer&) = delete;
+
+private:
+  long long* ns_;
+  std::chrono::steady_clock::time_point begin_;
+};
+
+// The stats argument may be null, in which case nothing is recorded.
+#define SUDOKU_STATS_ADD(stats, field, n) \
+  do { if (stats) (stats)->field += (n); } while (0)
+#define SUDOKU_STATS_NODE(stats, depth) \
+  do { if (stats) (stats)->addNode(depth); } while (0)
+#define SUDOKU_STATS_TIMER(stats, field) \
+  ScopedStatsTimer field##Timer((stats) ? &(stats)->field : nullptr)
+
+#else
+
+// The arguments are only named, so they don't warn as unused.
+#define SUDOKU_STATS_ADD(stats, field, n) \
+  do { (void) (stats); (void) sizeof(n); } while (0)
+#define SUDOKU_STATS_NODE(stats, depth) \
+  do { (void) (stats); (void) sizeof(depth); } while (0)
+#define SUDOKU_STATS_TIMER(stats, field) do { (void) (stats); } while (0)
+
+#endif
+
+} /* namespace sudoku */
+
+#endif /* SOLVE_STATS_H_ */
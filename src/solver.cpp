@@ -5,6 +5,8 @@
  *      Author: Vance Zuo
  */
 
+#include <climits>
+#include <cmath>
 #include <iterator>
 #include <utility>
 #include <algorithm>
@@ -16,66 +18,256 @@ using std::vector;
 
 namespace sudoku {
 
-Solver::Solver(Grid grid, VariableSortType varSortType, ValueSortType valSortType):
-    grid_(grid) {
+// Returns whether a limit has been reached, marking the solve aborted, and
+// otherwise schedules the next check.
+bool LimitCheck::check(long long steps) {
+  if (aborted_
+      || (limits_->maxNodes > 0 && steps >= limits_->maxNodes)
+      || (limits_->cancel && limits_->cancel->load(std::memory_order_relaxed))
+      || std::chrono::steady_clock::now() >= limits_->deadline) {
+    aborted_ = true;
+    return true;
+  }
+  next_ = steps + kInterval;
+  if (limits_->maxNodes > 0)
+    next_ = std::min(next_, limits_->maxNodes);
+  return false;
+}
+
+Solver::Solver(Grid grid, VariableSortType varSortType, ValueSortType valSortType,
+    PropagationLevel level):
+    grid_(grid), seed_(kDefaultSeed), rng_(kDefaultSeed),
+    restartPolicy_(RestartPolicy::NONE), restartBase_(kDefaultRestartBase),
+    stepLimit_(0), status_(SolveStatus::UNSOLVABLE),
+    collectStats_(false), work_(grid),
+    maxDepth_(0), numSolutions_(0), maxSolutions_(0) {
 
   varSortType_ = varSortType;
   valSortType_ = valSortType;
+  level_ = level;
+  reserve();
+}
+
+const uint64_t Solver::kDefaultSeed;
+const int Solver::kDefaultRestartBase;
+const int LimitCheck::kInterval;
+
+void Solver::setGrid(const Grid& grid) {
+  grid_ = grid;
+  work_ = grid;
+  // Later grids may have more blanks, so a reused solver makes room for
+  // moves at every depth up front.
+  moves_.reserve((grid_.size() + 1) * grid_.getMaxValue());
+  reserve();
+}
+
+void Solver::reserve() {
+  // Each depth assigns a different cell, so searches can't go deeper than
+  // the number of unsolved cells.
+  work_.reserve();
+  maxDepth_ = 0;
+  for (int i = 0; i < grid_.size(); ++i)
+    maxDepth_ += grid_.getValues(i).size() > 1;
+  moves_.resize((maxDepth_ + 1) * grid_.getMaxValue());
+  constrainings_.resize(grid_.getMaxValue() + 1);
+}
+
+void Solver::setSeed(uint64_t seed) {
+  seed_ = seed;
+  rng_.seed(seed);
+}
+
+void Solver::setRestartPolicy(RestartPolicy policy, int base) {
+  restartPolicy_ = policy;
+  restartBase_ = std::max(1, base);
+}
+
+long long Solver::getRestartBudget(RestartPolicy policy, int base, int run) {
+  switch (policy) {
+  case RestartPolicy::LUBY: {
+    // Finds the smallest complete subsequence 1, 1, 2, ..., 2^k holding the
+    // run, then descends into the half it falls in.
+    long long size = 1;
+    int k = 0;
+    while (size < run + 1) {
+      size = 2 * size + 1;
+      k++;
+    }
+    long long x = run;
+    while (size - 1 != x) {
+      size = (size - 1) / 2;
+      k--;
+      x %= size;
+    }
+    return (long long) base << k;
+  }
+  case RestartPolicy::GEOMETRIC:
+    return (long long) std::min(base * std::pow(1.5, run), 1e15);
+  default:
+    return 0;
+  }
 }
 
 bool Solver::solve(Grid& solution, int& steps) {
+  bool solved = false;
+  solveAll([&](const Grid&) {
+    solved = true;
+    return false;
+  }, steps);
+  // The search stops where it found the solution, so it is still in the
+  // working grid; clearing the trail first keeps it from being copied.
+  if (solved) {
+    work_.clearTrail();
+    solution = work_;
+  }
+  return solved;
+}
+
+int Solver::solveAll(vector<Grid>& solutions, vector<int>& steps,
+    int maxSolutions) {
+  int numSteps = 0;
+  solutions.clear();
+  steps.clear();
+  return solveAll([&](const Grid& grid) {
+    solutions.push_back(grid);
+    solutions.back().clearTrail();
+    steps.push_back(numSteps);
+    return true;
+  }, numSteps, maxSolutions);
+}
+
+int Solver::solveAll(const SolutionVisitor& visitor, int& steps,
+    int maxSolutions) {
   steps = 0;
-  return solve(solution, steps, grid_);
+  stats_.clear();
+  SolveStats* const stats = getActiveStats();
+  if (stats)
+    stats->depthNodes.reserve(maxDepth_ + 1);
+  Grid& grid = work_;
+  grid = grid_;
+  grid.clearTrail();
+  grid.setPropagationLevel(level_);
+  const long long propagations = grid.getNumPropagations();
+
+  numSolutions_ = 0;
+  maxSolutions_ = maxSolutions;
+  status_ = SolveStatus::UNSOLVABLE;
+  limitCheck_.start(limits_);
+  bool consistent;
+  {
+    SUDOKU_STATS_TIMER(stats, propagationNs);
+    consistent = grid.propagate();
+  }
+  SUDOKU_STATS_ADD(stats, eliminations, grid.getTrailMark());
+  rng_.seed(seed_);
+  for (int run = 0; consistent; ++run) {
+    stepLimit_ = restartPolicy_ == RestartPolicy::NONE ? 0
+        : steps + getRestartBudget(restartPolicy_, restartBase_, run);
+    const int mark = grid.getTrailMark();
+    // The search only stops early with a step limit left if it was cut off
+    // or aborted.
+    if (!search(grid, steps, 0, visitor) || stepLimit_ == 0
+        || limitCheck_.isAborted())
+      break;
+    grid.rollback(mark);
+    SUDOKU_STATS_ADD(stats, restarts, 1);
+  }
+  stepLimit_ = 0;
+  if (limitCheck_.isAborted())
+    status_ = SolveStatus::ABORTED;
+  else if (numSolutions_ > 0)
+    status_ = SolveStatus::SOLVED;
+  SUDOKU_STATS_ADD(stats, propagations,
+      grid.getNumPropagations() - propagations);
+  return numSolutions_;
 }
 
-bool Solver::solve(Grid& solution, int& steps, Grid& grid) {
-  int index = selectIndex(grid);
+int Solver::countSolutions(int& steps, int maxSolutions) {
+  return solveAll([](const Grid&) { return true; }, steps, maxSolutions);
+}
 
-  if (index == -1) {
-    solution = grid;
-    return true;
+bool Solver::hasUniqueSolution() {
+  int steps;
+  return countSolutions(steps, 2) == 1;
+}
+
+// Returns true if the visitor stopped the search, or the run was cut off or
+// aborted.
+bool Solver::search(Grid& grid, int& steps, int depth,
+    const SolutionVisitor& visitor) {
+  SolveStats* const stats = getActiveStats();
+  SUDOKU_STATS_NODE(stats, depth);
+
+  int index;
+  {
+    SUDOKU_STATS_TIMER(stats, selectionNs);
+    index = selectIndex(grid);
   }
 
-  vector<int> moves(begin(grid[index]), end(grid[index]));
-  sortMoves(grid, moves, index);
+  if (index == -1)
+    return !visit(grid, visitor);
+
+  int* const moves = &moves_[depth * grid.getMaxValue()];
+  int numMoves = 0;
+  {
+    SUDOKU_STATS_TIMER(stats, orderingNs);
+    for (auto value : grid.getValues(index))
+      moves[numMoves++] = value;
+    sortMoves(grid, moves, numMoves, index);
+  }
 
-  for (auto& value : moves) {
+  const int mark = grid.getTrailMark();
+  for (int i = 0; i < numMoves; ++i) {
+    const int value = moves[i];
+    if ((stepLimit_ > 0 && steps >= stepLimit_)
+        || limitCheck_(steps))
+      return true;
     steps++;
+    SUDOKU_STATS_ADD(stats, assignments, 1);
+
+    bool consistent;
+    {
+      SUDOKU_STATS_TIMER(stats, propagationNs);
+      consistent = grid.assign(index, value);
+    }
+    SUDOKU_STATS_ADD(stats, eliminations, grid.getTrailMark() - mark);
+    SUDOKU_STATS_ADD(stats, deadEnds, !consistent);
 
-    Grid nextGrid(grid);
-    if (nextGrid.assign(index, value) && solve(solution, steps, nextGrid))
+    if (consistent && search(grid, steps, depth + 1, visitor))
       return true;
+    grid.rollback(mark);
+    SUDOKU_STATS_ADD(stats, backtracks, 1);
   }
 
   return false;
 }
 
+// Counts a solution and returns whether to keep searching.
+bool Solver::visit(const Grid& grid, const SolutionVisitor& visitor) {
+  numSolutions_++;
+  stepLimit_ = 0;
+  return visitor(grid)
+      && (maxSolutions_ <= 0 || numSolutions_ < maxSolutions_);
+}
+
 int Solver::selectIndex(Grid& grid) {
   switch (varSortType_) {
-  case VariableSortType::MOST_CONSTRAINED: {
-    int minIndex = -1;
-    for (int i = 0; i < grid.size(); ++i) {
-      if (grid[i].size() == 1)
-        continue;
-      if (minIndex == -1 || grid[i].size() < grid[minIndex].size())
-        minIndex = i;
-    }
-    return minIndex;
-  }
+  case VariableSortType::MOST_CONSTRAINED:
+    return grid.getMostConstrainedIndex();
   case VariableSortType::RANDOMIZED: {
     int numUnset = 0;
     int randIndex = -1;
     for (int i = 0; i < grid.size(); ++i) {
-      if (grid[i].size() == 1)
+      if (grid.getValues(i).size() == 1)
         continue;
-      if (std::default_random_engine()() % ++numUnset < 1)
+      if (rng_() % ++numUnset == 0)
         randIndex = i;
     }
     return randIndex;
   }
   default: {
     for (int i = 0; i < grid.size(); ++i) {
-      if (grid[i].size() > 1)
+      if (grid.getValues(i).size() > 1)
         return i;
     }
     return -1;
@@ -83,26 +275,36 @@ int Solver::selectIndex(Grid& grid) {
   }
 }
 
-void Solver::sortMoves(Grid& grid, vector<int>& moves, int index) {
+void Solver::sortMoves(Grid& grid, int* moves, int numMoves, int index) {
   switch (valSortType_) {
   case ValueSortType::LEAST_CONSTRAINING: {
-    vector<int> constrainings(grid.getMaxValue() + 1);
-    for (auto& j : moves) {
-      for (auto& k : grid.getNeighbors(j)) {
-        constrainings[j] += grid[k].count(j);
-      }
+    // A value's score is how many cells in the row, column and box still
+    // allow it (cells in two of them counted twice); ties keep value order.
+    const int row = grid.getRowUnit(index);
+    const int col = grid.getColUnit(index);
+    const int box = grid.getBoxUnit(index);
+    int* const constrainings = constrainings_.data();
+    for (int i = 0; i < numMoves; ++i) {
+      const int j = moves[i];
+      constrainings[j] = grid.getUnitCount(row, j) + grid.getUnitCount(col, j)
+          + grid.getUnitCount(box, j);
+    }
+    // Insertion sort: stable, and moves are few.
+    for (int i = 1; i < numMoves; ++i) {
+      const int move = moves[i];
+      int j = i;
+      for (; j > 0 && constrainings[move] < constrainings[moves[j - 1]]; --j)
+        moves[j] = moves[j - 1];
+      moves[j] = move;
     }
-    std::sort(begin(moves), end(moves), [&](int a, int b) {
-      return constrainings[a] < constrainings[b];
-    });
   } break;
   case ValueSortType::RANDOMIZED:
-    std::shuffle(begin(moves), end(moves), std::default_random_engine());
+    std::shuffle(moves, moves + numMoves, rng_);
     break;
   default:
     break;
   }
-}
+}
 
 
 } /* namespace sudoku */
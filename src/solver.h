@@ -8,10 +8,16 @@
 #ifndef SOLVER_H_
 #define SOLVER_H_
 
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <random>
 #include <vector>
-#include <unordered_set>
 
 #include <src/grid.h>
+#include <src/solve_stats.h>
 
 namespace sudoku {
 
@@ -23,28 +29,172 @@ enum class ValueSortType {
   NONE, RANDOMIZED, LEAST_CONSTRAINING
 };
 
+// Restarts cut a run of the search off once it has taken a budget of steps
+// and start over from the root, with budgets that keep growing so the search
+// stays complete. They only help with randomized orderings, where each run
+// takes a different path: runs stuck in a bad subtree are cut short instead
+// of wandering in it. Budgets are a base times either the Luby sequence
+// (1, 1, 2, 1, 1, 2, 4, ...) or 1.5 to the power of the run.
+enum class RestartPolicy {
+  NONE, LUBY, GEOMETRIC
+};
+
+// Bounds on a solve, so that one pathological grid can't hold a thread for
+// minutes. A solve that reaches one stops where it is, with whatever stats it
+// has collected.
+struct SolveLimits {
+  // Steps (search nodes) a solve may take, or 0 for no limit.
+  long long maxNodes = 0;
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  // Once set, solves stop. Null for none.
+  const std::atomic<bool>* cancel = nullptr;
+
+  bool isBounded() const {
+    return maxNodes > 0 || cancel
+        || deadline != std::chrono::steady_clock::time_point::max();
+  }
+};
+
+enum class SolveStatus {
+  SOLVED,      // found a solution (solveAll: at least one, and finished)
+  UNSOLVABLE,  // searched the whole space without finding one
+  ABORTED      // stopped by the limits first
+};
+
+// Checks a solve's limits as its steps go by, shared by every search engine.
+// The clock and cancellation flag are only read every kInterval steps (and
+// the node limit is checked exactly), so the other steps cost a comparison.
+class LimitCheck {
+public:
+  static const int kInterval = 256;
+
+  // Starts checking the limits, which must outlive the solve, from step 0.
+  void start(const SolveLimits& limits) {
+    limits_ = &limits;
+    next_ = limits.isBounded() ? 0 : LLONG_MAX;
+    aborted_ = false;
+  }
+  // Returns whether the solve must stop once it has taken the given steps,
+  // which only grow during a solve. Keeps returning true once it has.
+  bool operator ()(long long steps) { return steps >= next_ && check(steps); }
+  bool isAborted() const { return aborted_; }
+
+private:
+  const SolveLimits* limits_ = nullptr;
+  // Steps at which the limits are checked next.
+  long long next_ = LLONG_MAX;
+  bool aborted_ = false;
+
+  bool check(long long steps);
+};
+
 class Solver {
 public:
   Solver(Grid grid,
       VariableSortType varSortType = VariableSortType::MOST_CONSTRAINED,
-      ValueSortType valSortType = ValueSortType::LEAST_CONSTRAINING);
+      ValueSortType valSortType = ValueSortType::LEAST_CONSTRAINING,
+      PropagationLevel level = PropagationLevel::NAKED_SINGLES);
 
   const Grid& getGrid() const { return grid_; }
+  // Replaces the grid to solve, keeping the solver's settings and the memory
+  // it has reserved. After the first call, a solver kept around for grids
+  // of the same dimensions doesn't allocate again.
+  void setGrid(const Grid& grid);
   ValueSortType getValSortType() const { return valSortType_; }
   VariableSortType getVarSortType() const { return varSortType_; }
+  PropagationLevel getPropagationLevel() const { return level_; }
+
+  // Randomized orderings draw from a generator that is reseeded at the start
+  // of each solve, so a solve is repeatable for a given seed.
+  uint64_t getSeed() const { return seed_; }
+  void setSeed(uint64_t seed);
+
+  RestartPolicy getRestartPolicy() const { return restartPolicy_; }
+  int getRestartBase() const { return restartBase_; }
+  // Restarts stop once a solution has been found, so solveAll never reports
+  // a solution twice.
+  void setRestartPolicy(RestartPolicy policy, int base = kDefaultRestartBase);
+  // Step budget of the given run (counting from 0).
+  static long long getRestartBudget(RestartPolicy policy, int base, int run);
+
+  // The limits are checked every LimitCheck::kInterval steps, so a solve
+  // stops at most that many steps past a deadline or cancellation (the node
+  // limit is exact). None by default.
+  const SolveLimits& getLimits() const { return limits_; }
+  void setLimits(const SolveLimits& limits) { limits_ = limits; }
+  void setCancelFlag(const std::atomic<bool>* cancel) {
+    limits_.cancel = cancel;
+  }
+  // How the last solve ended. Solves that hit a limit return what they found
+  // up to that point (false, or the solutions so far).
+  SolveStatus getStatus() const { return status_; }
+
+  static const uint64_t kDefaultSeed = std::mt19937_64::default_seed;
+  static const int kDefaultRestartBase = 100;
 
+  // Called with each solution found; returns whether to keep searching.
+  typedef std::function<bool(const Grid&)> SolutionVisitor;
+
+  // A solver reserves the memory its searches need when it is constructed
+  // (a working grid with room for its longest trail, and move lists for
+  // every depth), so solves don't allocate, apart from growing the solution
+  // grid (no growth if it already has the same dimensions), search stats
+  // and the visitor's own allocations. Grids with more than 64 values per
+  // cell are the exception, as copying their candidates allocates.
   bool solve(Grid& solution, int& steps);
-  // bool solveAll(std::vector<Grid>& solutions, std::vector<int>& steps);
+  int solveAll(std::vector<Grid>& solutions, std::vector<int>& steps,
+      int maxSolutions = 0);
+  int solveAll(const SolutionVisitor& visitor, int& steps,
+      int maxSolutions = 0);
+  int countSolutions(int& steps, int maxSolutions = 0);
+  bool hasUniqueSolution();
+
+  // When enabled, each solve records search counters and timings, which
+  // getStats returns until the next solve. Timing every node has a cost, so
+  // this is off by default.
+  bool isCollectingStats() const { return collectStats_; }
+  void setCollectStats(bool enabled) { collectStats_ = enabled; }
+  const SolveStats& getStats() const { return stats_; }
 
 private:
+  friend class ParallelSolver;
+
   Grid grid_;
 
   VariableSortType varSortType_;
   ValueSortType valSortType_;
+  PropagationLevel level_;
+
+  uint64_t seed_;
+  std::mt19937_64 rng_;
+  RestartPolicy restartPolicy_;
+  int restartBase_;
+  // Steps at which the current run is cut off, or 0 for none.
+  long long stepLimit_;
+  SolveLimits limits_;
+  LimitCheck limitCheck_;
+  SolveStatus status_;
+
+  bool collectStats_;
+  SolveStats stats_;
+
+  // Search state: the grid being searched, the moves of each depth (a
+  // block of getMaxValue() values per depth), and value scores for
+  // sortMoves.
+  Grid work_;
+  int maxDepth_;
+  std::vector<int> moves_;
+  std::vector<int> constrainings_;
+  int numSolutions_, maxSolutions_;
 
-  bool solve(Grid& solution, int& steps, Grid& grid);
+  void reserve();
+  SolveStats* getActiveStats() { return collectStats_ ? &stats_ : nullptr; }
+  bool search(Grid& grid, int& steps, int depth,
+      const SolutionVisitor& visitor);
+  bool visit(const Grid& grid, const SolutionVisitor& visitor);
   int selectIndex(Grid& grid);
-  void sortMoves(Grid& grid, std::vector<int>& moves, int index);
+  void sortMoves(Grid& grid, int* moves, int numMoves, int index);
 };
 
 } /* namespace sudoku */
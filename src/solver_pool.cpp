@@ -0,0 +1,157 @@
+/*
+ * solver_pool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include <src/solver_pool.h>
+
+using std::vector;
+
+namespace sudoku {
+
+SolverPool::SolverPool(int numThreads, PropagationLevel level,
+    const SolveLimits& limits):
+    level_(level), limits_(limits), queued_(0), closing_(false), next_(0) {
+  if (numThreads < 1)
+    numThreads = 1;
+  for (int i = 0; i < numThreads; ++i)
+    workers_.emplace_back(new Worker());
+  for (int i = 0; i < numThreads; ++i)
+    threads_.emplace_back(&SolverPool::run, this, i);
+}
+
+SolverPool::~SolverPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+  }
+  jobAdded_.notify_all();
+  for (auto& thread : threads_)
+    thread.join();
+}
+
+std::future<SolverPool::Result> SolverPool::submit(const Grid& grid,
+    const Callback& callback) {
+  return std::move(submitBatch(&grid, 1, callback).front());
+}
+
+vector<std::future<SolverPool::Result>> SolverPool::submitBatch(
+    const vector<Grid>& grids, const Callback& callback) {
+  return submitBatch(grids.data(), grids.size(), callback);
+}
+
+vector<std::future<SolverPool::Result>> SolverPool::submitBatch(
+    const Grid* grids, int numGrids, const Callback& callback) {
+  vector<std::future<Result>> futures;
+  if (numGrids <= 0)
+    return futures;
+  futures.reserve(numGrids);
+  std::shared_ptr<const Callback> shared;
+  if (callback)
+    shared = std::make_shared<const Callback>(callback);
+
+  const int numWorkers = workers_.size();
+  const int numRuns = std::min(numGrids, numWorkers);
+  int first;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    first = next_;
+    next_ = (next_ + numRuns) % numWorkers;
+  }
+  // The grids are copied before taking a worker's lock, which the worker
+  // needs for every job it takes.
+  std::deque<Job> run;
+  for (int i = 0, end = 0; i < numRuns; ++i) {
+    const int begin = end;
+    end = (long long) numGrids * (i + 1) / numRuns;
+    for (int index = begin; index < end; ++index) {
+      run.emplace_back();
+      run.back().grid = grids[index];
+      run.back().index = index;
+      run.back().callback = shared;
+      futures.push_back(run.back().promise.get_future());
+    }
+    Worker& worker = *workers_[(first + i) % numWorkers];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    for (auto& job : run)
+      worker.jobs.push_back(std::move(job));
+    run.clear();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queued_ += numGrids;
+  }
+  jobAdded_.notify_all();
+  return futures;
+}
+
+void SolverPool::run(int id) {
+  Worker& worker = *workers_[id];
+  Job job;
+  while (pop(id, job))
+    execute(worker, job);
+}
+
+// Waits for a job and takes it: the worker's oldest, or else another
+// worker's newest, so the other worker's run stays in order. Returns false
+// once the pool is closing and every job is taken.
+bool SolverPool::pop(int id, Job& job) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    jobAdded_.wait(lock, [&] { return closing_ || queued_ > 0; });
+    if (queued_ == 0)
+      return false;
+    // Claims a job, which is in some queue until its claimer takes it.
+    queued_--;
+  }
+  const int numWorkers = workers_.size();
+  for (;;) {
+    for (int i = 0; i < numWorkers; ++i) {
+      Worker& victim = *workers_[(id + i) % numWorkers];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.jobs.empty())
+        continue;
+      if (i == 0) {
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+      } else {
+        job = std::move(victim.jobs.back());
+        victim.jobs.pop_back();
+      }
+      return true;
+    }
+    // Another worker took the job this one passed over; the one it claimed
+    // is still queued somewhere.
+    std::this_thread::yield();
+  }
+}
+
+void SolverPool::execute(Worker& worker, Job& job) {
+  auto begin = std::chrono::steady_clock::now();
+  if (worker.solver) {
+    worker.solver->setGrid(job.grid);
+  } else {
+    worker.solver.reset(new Solver(job.grid,
+        VariableSortType::MOST_CONSTRAINED, ValueSortType::LEAST_CONSTRAINING,
+        level_));
+    worker.solver->setLimits(limits_);
+  }
+
+  Result result;
+  worker.solver->solve(result.solution, result.steps);
+  result.status = worker.solver->getStatus();
+  result.ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - begin).count();
+  if (job.callback)
+    (*job.callback)(job.index, result);
+  job.promise.set_value(std::move(result));
+  job.callback.reset();
+}
+
+} /* namespace sudoku */
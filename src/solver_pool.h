@@ -0,0 +1,102 @@
+/*
+ * solver_pool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SOLVER_POOL_H_
+#define SOLVER_POOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <src/grid.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Solves grids on a pool of worker threads that lives as long as the pool,
+// so callers submit grids and carry on instead of blocking in a solve. Each
+// worker has its own queue: a batch is split into one contiguous run of
+// grids per worker, and workers that run out steal from the far end of
+// another's queue. Each worker also keeps one Solver, reset to each grid it
+// takes, so its search memory is reused from grid to grid.
+class SolverPool {
+public:
+  struct Result {
+    SolveStatus status = SolveStatus::UNSOLVABLE;
+    Grid solution;  // when solved
+    int steps = 0;
+    long long ns = 0;
+  };
+
+  // Called on the worker thread with a grid's position in its batch (0 for
+  // a single grid) and its result, just before its future becomes ready.
+  // Must not throw.
+  typedef std::function<void(int index, const Result& result)> Callback;
+
+  // Solves with the default search heuristics at the given propagation
+  // level, stopping each solve at the limits (the node limit and
+  // cancellation flag apply to each solve, the deadline to all of them).
+  explicit SolverPool(int numThreads,
+      PropagationLevel level = PropagationLevel::NAKED_SINGLES,
+      const SolveLimits& limits = SolveLimits());
+  // Finishes the grids already submitted, then stops the workers.
+  ~SolverPool();
+
+  SolverPool(const SolverPool&) = delete;
+  SolverPool& operator =(const SolverPool&) = delete;
+
+  int getNumThreads() const { return threads_.size(); }
+
+  std::future<Result> submit(const Grid& grid,
+      const Callback& callback = nullptr);
+  // Returns the futures of grids[0], ..., grids[numGrids - 1] in order.
+  std::vector<std::future<Result>> submitBatch(const Grid* grids,
+      int numGrids, const Callback& callback = nullptr);
+  std::vector<std::future<Result>> submitBatch(const std::vector<Grid>& grids,
+      const Callback& callback = nullptr);
+
+private:
+  struct Job {
+    Grid grid;
+    int index;
+    std::shared_ptr<const Callback> callback;
+    std::promise<Result> promise;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+    // Created for the worker's first grid.
+    std::unique_ptr<Solver> solver;
+  };
+
+  PropagationLevel level_;
+  SolveLimits limits_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  // Counts jobs in the queues, so idle workers know when to wake.
+  std::mutex mutex_;
+  std::condition_variable jobAdded_;
+  int queued_;
+  bool closing_;
+  // Worker that gets the next single grid or batch.
+  int next_;
+
+  void run(int id);
+  bool pop(int id, Job& job);
+  void execute(Worker& worker, Job& job);
+};
+
+} /* namespace sudoku */
+
+#endif /* SOLVER_POOL_H_ */
@@ -0,0 +1,112 @@
+/*
+ * candidates_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/candidates.h>
+
+using testing::ElementsAre;
+
+namespace sudoku {
+
+// Tests for the Candidates class.
+
+// Tests constructor with max value argument.
+TEST(Candidates, constructorMaxValue) {
+  const Candidates candidates(9);
+
+  EXPECT_EQ(candidates.getMaxValue(), 9);
+  EXPECT_EQ(candidates.getNumWords(), 1);
+  EXPECT_TRUE(candidates.empty());
+  EXPECT_EQ(candidates.size(), 0);
+}
+
+// Tests filling with every value.
+TEST(Candidates, fill) {
+  Candidates candidates(9);
+  candidates.fill();
+
+  EXPECT_EQ(candidates.size(), 9);
+  EXPECT_EQ(candidates.count(0), 0);
+  for (int i = 1; i <= 9; ++i)
+    EXPECT_EQ(candidates.count(i), 1);
+  EXPECT_EQ(candidates.count(10), 0);
+}
+
+// Tests the emplace and erase methods.
+TEST(Candidates, emplaceErase) {
+  Candidates candidates(16);
+
+  EXPECT_TRUE(candidates.emplace(16));
+  EXPECT_FALSE(candidates.emplace(16));
+  EXPECT_FALSE(candidates.emplace(17));
+  EXPECT_EQ(candidates.size(), 1);
+  EXPECT_EQ(candidates.erase(16), 1);
+  EXPECT_EQ(candidates.erase(16), 0);
+  EXPECT_TRUE(candidates.empty());
+}
+
+// Tests iteration is in ascending value order.
+TEST(Candidates, iterate) {
+  Candidates candidates(9);
+  candidates.emplace(7);
+  candidates.emplace(2);
+  candidates.emplace(9);
+
+  std::vector<int> values(candidates.begin(), candidates.end());
+  EXPECT_THAT(values, ElementsAre(2, 7, 9));
+  EXPECT_EQ(candidates.front(), 2);
+}
+
+// Tests masks spanning several words.
+TEST(Candidates, multiWord) {
+  Candidates candidates(100);
+  candidates.fill();
+
+  EXPECT_EQ(candidates.getNumWords(), 2);
+  EXPECT_EQ(candidates.size(), 100);
+  EXPECT_EQ(candidates.count(64), 1);
+  EXPECT_EQ(candidates.count(65), 1);
+  EXPECT_EQ(candidates.count(101), 0);
+
+  candidates.setOnly(70);
+  std::vector<int> values(candidates.begin(), candidates.end());
+  EXPECT_THAT(values, ElementsAre(70));
+
+  Candidates copy(candidates);
+  EXPECT_EQ(copy, candidates);
+  copy.emplace(3);
+  EXPECT_NE(copy, candidates);
+}
+
+// Tests the mask operations.
+TEST(Candidates, maskOps) {
+  Candidates a(9), b(9);
+  for (int i : { 1, 2, 3 })
+    a.emplace(i);
+  for (int i : { 2, 3 })
+    b.emplace(i);
+
+  EXPECT_TRUE(b.isSubsetOf(a));
+  EXPECT_FALSE(a.isSubsetOf(b));
+  EXPECT_TRUE(a.intersects(b));
+
+  Candidates c(a);
+  c.removeAll(b);
+  EXPECT_THAT(std::vector<int>(c.begin(), c.end()), ElementsAre(1));
+  EXPECT_FALSE(c.intersects(b));
+
+  c |= b;
+  EXPECT_EQ(c, a);
+  c &= b;
+  EXPECT_EQ(c, b);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,173 @@
+/*
+ * canonicalizer_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/canonicalizer.h>
+#include <test/solution_check.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace canonicalizerTest {
+
+const vector<int>& initVec = solutionCheck::hardVec;
+
+// Order of groups of size lines (bands or stacks), with the lines in each
+// group shuffled too.
+vector<int> shuffleLines(int numGroups, int size, std::mt19937& rng) {
+  vector<int> groups(numGroups), lines;
+  for (int i = 0; i < numGroups; ++i)
+    groups[i] = i;
+  std::shuffle(groups.begin(), groups.end(), rng);
+  for (auto group : groups) {
+    vector<int> offsets(size);
+    for (int i = 0; i < size; ++i)
+      offsets[i] = i;
+    std::shuffle(offsets.begin(), offsets.end(), rng);
+    for (auto offset : offsets)
+      lines.push_back(group * size + offset);
+  }
+  return lines;
+}
+
+// A random symmetry of grids with the given dimensions.
+GridTransform randomTransform(int subrows, int subcols, std::mt19937& rng) {
+  GridTransform transform;
+  transform.side = subrows * subcols;
+  transform.transposed = subrows == subcols && rng() % 2;
+  transform.rows = shuffleLines(subcols, subrows, rng);
+  transform.cols = shuffleLines(subrows, subcols, rng);
+  transform.labels.push_back(0);
+  for (int value = 1; value <= transform.side; ++value)
+    transform.labels.push_back(value);
+  std::shuffle(transform.labels.begin() + 1, transform.labels.end(), rng);
+  return transform;
+}
+
+string toString(const vector<int>& values) {
+  string result;
+  for (auto value : values)
+    result += '0' + value;
+  return result;
+}
+
+} /* namespace canonicalizerTest */
+
+using namespace canonicalizerTest;
+
+// Tests for the GridTransform struct.
+
+TEST(GridTransform, invert) {
+  std::mt19937 rng(1);
+  for (int i = 0; i < 10; ++i) {
+    const GridTransform transform = randomTransform(3, 3, rng);
+    EXPECT_EQ(transform.invert(transform.apply(initVec)), initVec);
+  }
+}
+
+// Tests for the Canonicalizer class.
+
+// Tests equivalent grids share a form, which is their smallest image and
+// what the returned transform maps them to.
+TEST(Canonicalizer, canonicalize) {
+  Canonicalizer canonicalizer(3, 3);
+  GridTransform transform;
+  const string form = canonicalizer.canonicalize(initVec, transform);
+
+  EXPECT_TRUE(canonicalizer.isReorderingLines());
+  EXPECT_EQ(form.size(), 81u);
+  EXPECT_EQ(toString(transform.apply(initVec)), form);
+  std::mt19937 rng(2);
+  for (int i = 0; i < 20; ++i) {
+    const vector<int> image = randomTransform(3, 3, rng).apply(initVec);
+    GridTransform imageTransform;
+    EXPECT_EQ(canonicalizer.canonicalize(image, imageTransform), form);
+    EXPECT_EQ(toString(imageTransform.apply(image)), form);
+    EXPECT_LE(form, toString(image));
+  }
+}
+
+TEST(Canonicalizer, canonicalizeDifferent) {
+  Canonicalizer canonicalizer(3, 3);
+  GridTransform transform;
+  vector<int> other(initVec);
+  other[80] = 2;
+
+  EXPECT_NE(canonicalizer.canonicalize(other, transform),
+      canonicalizer.canonicalize(initVec, transform));
+}
+
+TEST(Canonicalizer, canonicalizeGrid) {
+  Canonicalizer canonicalizer(3, 3);
+  GridTransform transform;
+  const Grid grid(3, 3, initVec);
+
+  EXPECT_EQ(canonicalizer.canonicalize(grid, transform),
+      canonicalizer.canonicalize(initVec, transform));
+}
+
+TEST(Canonicalizer, canonicalizeRectangular) {
+  const vector<int> initVec = {
+      1, 0, 0,  0, 0, 0,
+      0, 0, 0,  2, 0, 0,
+
+      0, 3, 0,  0, 0, 4,
+      0, 0, 0,  0, 1, 0,
+
+      0, 0, 5,  0, 0, 0,
+      6, 0, 0,  0, 0, 0,
+  };
+  Canonicalizer canonicalizer(2, 3);
+  GridTransform transform;
+  const string form = canonicalizer.canonicalize(initVec, transform);
+
+  std::mt19937 rng(3);
+  for (int i = 0; i < 20; ++i) {
+    const vector<int> image = randomTransform(2, 3, rng).apply(initVec);
+    EXPECT_EQ(canonicalizer.canonicalize(image, transform), form);
+    EXPECT_LE(form, toString(image));
+  }
+}
+
+// Tests grids with too many column orders still map equivalent grids that
+// only differ in band and stack order and labels to one form.
+TEST(Canonicalizer, canonicalizeLarge) {
+  Canonicalizer canonicalizer(4, 4);
+  vector<int> values(256);
+  values[0] = 1;
+  values[21] = 2;
+  values[130] = 3;
+  values[255] = 4;
+  GridTransform transform;
+  const string form = canonicalizer.canonicalize(values, transform);
+
+  EXPECT_FALSE(canonicalizer.isReorderingLines());
+  EXPECT_TRUE(canonicalizer.isReorderingBoxes());
+  EXPECT_EQ(toString(transform.apply(values)), form);
+  GridTransform swap;
+  swap.side = 16;
+  swap.transposed = true;
+  swap.labels.push_back(0);
+  for (int i = 0; i < 16; ++i) {
+    swap.rows.push_back((i + 4) % 16);
+    swap.cols.push_back((i + 8) % 16);
+    swap.labels.push_back(16 - i);
+  }
+  EXPECT_EQ(canonicalizer.canonicalize(swap.apply(values), transform), form);
+}
+
+} /* namespace sudoku */
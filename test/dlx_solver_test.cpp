@@ -0,0 +1,94 @@
+/*
+ * dlx_solver_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <chrono>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/dlx_solver.h>
+#include <test/solution_check.h>
+
+namespace sudoku {
+
+// Tests for the DlxSolver class.
+
+// Tests the solve method.
+TEST(DlxSolver, solve) {
+  const Grid initGrid(3, 3, solutionCheck::initVec);
+  const Grid solutionGrid(3, 3, solutionCheck::solutionVec);
+  DlxSolver solver(initGrid);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getValues(), solutionGrid.getValues());
+  EXPECT_GE(steps, 1);
+  EXPECT_EQ(solver.getGrid().getValues(), initGrid.getValues());
+}
+
+TEST(DlxSolver, solveNoSolution) {
+  const std::vector<int> initVec = {
+      1, 2,  0, 0,
+      0, 0,  3, 0,
+      0, 0,  0, 3,
+      0, 0,  0, 0,
+  };
+  DlxSolver solver(Grid(2, 2, initVec));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::UNSOLVABLE);
+}
+
+TEST(DlxSolver, solveEmptyLarge) {
+  DlxSolver solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_TRUE(solutionCheck::isSolved(solution));
+}
+
+TEST(DlxSolver, solveRectangular) {
+  DlxSolver solver(Grid(2, 3));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getNumRows(), 6);
+  EXPECT_TRUE(solutionCheck::isSolved(solution));
+}
+
+// Tests a node limit and a passed deadline both abort.
+TEST(DlxSolver, setLimits) {
+  DlxSolver solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  SolveLimits limits;
+  limits.maxNodes = 1;
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 1);
+
+  limits = SolveLimits();
+  limits.deadline = std::chrono::steady_clock::now();
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 0);
+
+  solver.setLimits(SolveLimits());
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+}
+
+} /* namespace sudoku */
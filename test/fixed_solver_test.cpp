@@ -0,0 +1,162 @@
+/*
+ * fixed_solver_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <chrono>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/fixed_solver.h>
+#include <src/solver.h>
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace fixedSolverTest {
+
+const std::vector<int> initVec = {
+    0, 9, 4,  0, 0, 0,  1, 3, 0,
+    0, 0, 0,  0, 0, 0,  0, 0, 0,
+    0, 0, 0,  0, 7, 6,  0, 0, 2,
+
+    0, 8, 0,  0, 1, 0,  0, 0, 0,
+    0, 3, 2,  0, 0, 0,  0, 0, 0,
+    0, 0, 0,  2, 0, 0,  0, 6, 0,
+
+    0, 0, 0,  0, 5, 0,  4, 0, 0,
+    0, 0, 0,  0, 0, 8,  0, 0, 7,
+    0, 0, 6,  3, 0, 4,  0, 0, 8,
+};
+
+template <int SubRows, int SubCols>
+void expectSameSearch(const Grid& grid) {
+  Grid fixedSolution, solution;
+  int fixedSteps = 0, steps = 0;
+
+  bool fixedSolved = FixedSolver<SubRows, SubCols>(grid).solve(fixedSolution,
+      fixedSteps);
+  bool solved = Solver(grid).solve(solution, steps);
+
+  EXPECT_EQ(fixedSolved, solved);
+  EXPECT_EQ(fixedSteps, steps);
+  if (solved) {
+    EXPECT_EQ(fixedSolution.getValues(), solution.getValues());
+  }
+}
+
+// Checks a FixedPeers table lists the same peers as Grid, in order.
+template <int SubRows, int SubCols>
+void expectSamePeers() {
+  const Grid grid(SubRows, SubCols);
+  const FixedPeers<SubRows, SubCols>& peers =
+      FixedGrid<SubRows, SubCols>::getPeers();
+  for (int i = 0; i < grid.size(); ++i) {
+    EXPECT_THAT(grid.getNeighbors(i), testing::ElementsAreArray(
+        peers.peers[i], FixedPeers<SubRows, SubCols>::kNumPeers)) << i;
+  }
+}
+
+} /* namespace fixedSolverTest */
+
+// Tests for the FixedPeers table.
+
+// Tests the compile-time tables, including the largest one and boxes that
+// are wider than tall and taller than wide.
+TEST(FixedPeers, matchesGrid) {
+  fixedSolverTest::expectSamePeers<3, 3>();
+  fixedSolverTest::expectSamePeers<2, 3>();
+  fixedSolverTest::expectSamePeers<3, 2>();
+  fixedSolverTest::expectSamePeers<5, 5>();
+}
+
+// Tests for the FixedGrid class.
+
+TEST(FixedGrid, roundTrip) {
+  const Grid grid(3, 3, fixedSolverTest::initVec);
+  const FixedGrid<3, 3> fixed(grid);
+
+  EXPECT_EQ(fixed.toGrid().getValues(), grid.getValues());
+}
+
+// Tests writing into an existing grid replaces its values, or the grid if
+// its dimensions differ.
+TEST(FixedGrid, toGridReuse) {
+  const Grid grid(3, 3, fixedSolverTest::initVec);
+  const FixedGrid<3, 3> fixed(grid);
+  Grid reused(3, 3), other(2, 2);
+  ASSERT_TRUE(reused.assign(0, 1));
+
+  fixed.toGrid(reused);
+  fixed.toGrid(other);
+  EXPECT_EQ(reused.getValues(), grid.getValues());
+  EXPECT_EQ(reused.getTrailMark(), 0);
+  EXPECT_EQ(other.getValues(), grid.getValues());
+}
+
+TEST(FixedGrid, assign) {
+  FixedGrid<2, 2> grid;
+
+  EXPECT_TRUE(grid.assign(0, 1));
+  EXPECT_EQ(grid[0], 1u);
+  EXPECT_EQ(grid[1] & 1u, 0u);
+  EXPECT_FALSE(grid.assign(1, 1));
+  EXPECT_FALSE(grid.assign(0, 1));
+}
+
+// Tests for the FixedSolver class.
+
+// Tests the search matches Solver's.
+TEST(FixedSolver, solveMatchesSolver) {
+  fixedSolverTest::expectSameSearch<3, 3>(
+      Grid(3, 3, fixedSolverTest::initVec));
+  fixedSolverTest::expectSameSearch<3, 3>(Grid(3, 3));
+  fixedSolverTest::expectSameSearch<2, 3>(Grid(2, 3));
+  fixedSolverTest::expectSameSearch<4, 4>(Grid(4, 4));
+}
+
+TEST(FixedSolver, solveNoSolution) {
+  const std::vector<int> initVec = {
+      1, 2,  0, 0,
+      0, 0,  3, 0,
+      0, 0,  0, 3,
+      0, 0,  0, 0,
+  };
+  FixedSolver<2, 2> solver(Grid(2, 2, initVec));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::UNSOLVABLE);
+}
+
+// Tests a node limit and a passed deadline both abort.
+TEST(FixedSolver, setLimits) {
+  FixedSolver<4, 4> solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  SolveLimits limits;
+  limits.maxNodes = 1;
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 1);
+
+  limits = SolveLimits();
+  limits.deadline = std::chrono::steady_clock::now();
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 0);
+
+  solver.setLimits(SolveLimits());
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,81 @@
+/*
+ * generator_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/generator.h>
+
+using testing::ElementsAre;
+using testing::UnorderedElementsAre;
+
+namespace sudoku {
+
+// Tests for the Generator class.
+
+// Tests the fill method returns a complete, valid grid.
+TEST(Generator, fill) {
+  Generator generator(2, 3);
+  const std::vector<int> values = generator.fill();
+  const Grid grid(2, 3, values);
+
+  ASSERT_EQ(values.size(), 36u);
+  for (int i = 0; i < grid.size(); ++i) {
+    EXPECT_EQ(grid.getValues(i).size(), 1);
+    EXPECT_EQ(grid.getValues(i).front(), values[i]);
+  }
+}
+
+// Tests the orbits of each symmetry.
+TEST(Generator, getOrbit) {
+  EXPECT_THAT(Generator(3, 3, Symmetry::NONE).getOrbit(1), ElementsAre(1));
+  EXPECT_THAT(Generator(3, 3, Symmetry::ROTATIONAL).getOrbit(1),
+      UnorderedElementsAre(1, 79));
+  EXPECT_THAT(Generator(3, 3, Symmetry::ROTATIONAL).getOrbit(40),
+      ElementsAre(40));
+  EXPECT_THAT(Generator(3, 3, Symmetry::MIRROR).getOrbit(10),
+      UnorderedElementsAre(10, 16));
+}
+
+// Tests generated puzzles are unique, minimal, symmetric and repeatable.
+TEST(Generator, generate) {
+  for (auto symmetry : {Symmetry::NONE, Symmetry::ROTATIONAL,
+      Symmetry::MIRROR}) {
+    Generator generator(3, 3, symmetry, 7);
+    std::vector<int> puzzle, solution;
+    generator.generate(puzzle, solution);
+
+    EXPECT_TRUE(generator.hasUniqueSolution(puzzle));
+    Grid solutionGrid;
+    int steps;
+    ASSERT_TRUE(Solver(Grid(3, 3, puzzle)).solve(solutionGrid, steps));
+    for (int i = 0; i < 81; ++i) {
+      EXPECT_EQ(solutionGrid.getValues(i).front(), solution[i]);
+      if (puzzle[i] != 0) {
+        EXPECT_EQ(puzzle[i], solution[i]);
+      }
+      for (auto& cell : generator.getOrbit(i))
+        EXPECT_EQ(puzzle[cell] != 0, puzzle[i] != 0);
+    }
+    for (int i = 0; i < 81; ++i) {
+      if (puzzle[i] == 0)
+        continue;
+      std::vector<int> removed(puzzle);
+      for (auto& cell : generator.getOrbit(i))
+        removed[cell] = 0;
+      EXPECT_FALSE(generator.hasUniqueSolution(removed));
+    }
+
+    std::vector<int> repeatPuzzle, repeatSolution;
+    Generator(3, 3, symmetry, 7).generate(repeatPuzzle, repeatSolution);
+    EXPECT_EQ(repeatPuzzle, puzzle);
+  }
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,78 @@
+/*
+ * grid_layout_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/grid.h>
+#include <src/grid_layout.h>
+
+using testing::ElementsAre;
+
+namespace sudoku {
+
+// Tests for the GridLayout class.
+
+// Tests layouts are shared between grids of the same dimensions.
+TEST(GridLayout, interned) {
+  const Grid a(3, 3), b(3, 3), c(2, 3);
+
+  EXPECT_EQ(&a.getLayout(), &b.getLayout());
+  EXPECT_NE(&a.getLayout(), &c.getLayout());
+  EXPECT_EQ(GridLayout::get(3, 3).get(), &a.getLayout());
+}
+
+TEST(GridLayout, internedConcurrently) {
+  std::vector<std::shared_ptr<const GridLayout>> layouts(8);
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0; i < layouts.size(); ++i)
+    threads.emplace_back([&, i] { layouts[i] = GridLayout::get(4, 5); });
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto& layout : layouts)
+    EXPECT_EQ(layout, layouts[0]);
+}
+
+// Tests the CSR peer table.
+TEST(GridLayout, getPeers) {
+  const std::shared_ptr<const GridLayout> layout = GridLayout::get(2, 2);
+
+  EXPECT_TRUE(layout->isNarrow());
+  for (int i = 0; i < layout->size(); ++i)
+    EXPECT_EQ(layout->getNumPeers(i), 7);
+  EXPECT_THAT(layout->getPeers(0), ElementsAre(1, 2, 3, 4, 5, 8, 12));
+  EXPECT_THAT(layout->getPeers(15), ElementsAre(3, 7, 10, 11, 12, 13, 14));
+}
+
+// Tests the unit tables.
+TEST(GridLayout, getUnit) {
+  const std::shared_ptr<const GridLayout> layout = GridLayout::get(2, 2);
+
+  EXPECT_EQ(layout->getNumUnits(), 12);
+  EXPECT_THAT(layout->getUnit(1), ElementsAre(4, 5, 6, 7));
+  EXPECT_THAT(layout->getUnit(4 + 1), ElementsAre(1, 5, 9, 13));
+  EXPECT_THAT(layout->getUnit(8 + 3), ElementsAre(10, 11, 14, 15));
+}
+
+// Tests a 1x1 layout, which has no peers, is still narrow.
+TEST(GridLayout, single) {
+  const std::shared_ptr<const GridLayout> layout = GridLayout::get(1, 1);
+
+  EXPECT_TRUE(layout->isNarrow());
+  EXPECT_EQ(layout->getNumPeers(0), 0);
+  EXPECT_THAT(layout->getPeers(0), testing::IsEmpty());
+  EXPECT_EQ(layout->getNumUnits(), 3);
+  for (int unit = 0; unit < 3; ++unit)
+    EXPECT_THAT(layout->getUnit(unit), ElementsAre(0));
+}
+
+} /* namespace sudoku */
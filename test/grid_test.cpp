@@ -5,7 +5,6 @@
  *      Author: Vance Zuo
  */
 
-#include <unordered_set>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -13,7 +12,9 @@
 
 #include <src/grid.h>
 
+using testing::Contains;
 using testing::Each;
+using testing::ElementsAre;
 using testing::Eq;
 using testing::ContainerEq;
 
@@ -61,6 +62,18 @@ TEST(Grid, constructorThreeArgs) {
       EXPECT_LE(grid.getValues(i).count(j), 1);
 }
 
+// Tests constructors for a 1x1 grid, whose one cell has no peers.
+TEST(Grid, constructorSingle) {
+  const Grid empty(1, 1);
+  const Grid given(1, 1, std::vector<int>{ 1 });
+
+  EXPECT_EQ(empty.size(), 1);
+  EXPECT_EQ(empty.getNumUnits(), 3);
+  EXPECT_EQ(empty.getValues(0).size(), 1);
+  EXPECT_EQ(empty.getValues(0).front(), 1);
+  EXPECT_EQ(given.getValues(0).size(), 1);
+}
+
 // Tests the operator ().
 TEST(Grid, operatorParenthesis) {
   const int subrows = 1, subcols = 2;
@@ -68,8 +81,10 @@ TEST(Grid, operatorParenthesis) {
 
   for (int i = 0; i < grid.getNumRows(); i++) {
     for (int j = 0; j < grid.getNumCols(); j++) {
-      grid(i, j).emplace(99);
-      EXPECT_TRUE(grid(i, j).count(99) == 1);
+      grid(i, j).erase(1);
+      ASSERT_TRUE(grid(i, j).count(1) == 0);
+      grid(i, j).emplace(1);
+      EXPECT_TRUE(grid(i, j).count(1) == 1);
     }
   }
 }
@@ -80,8 +95,10 @@ TEST(Grid, operatorBrackets) {
   Grid grid(subrows, subcols);
 
   for (int i = 0; i < grid.size(); i++) {
-    grid[i].emplace(99);
-    EXPECT_TRUE(grid[i].count(99) == 1);
+    grid[i].erase(1);
+    ASSERT_TRUE(grid[i].count(1) == 0);
+    grid[i].emplace(1);
+    EXPECT_TRUE(grid[i].count(1) == 1);
   }
 }
 
@@ -132,9 +149,9 @@ TEST(Grid, getValuesRowCol) {
 
   for (int i = 0; i < grid.getNumRows(); i++) {
     for (int j = 0; j < grid.getNumCols(); j++) {
-      grid(i, j).emplace(99);
-      ASSERT_TRUE(grid(i, j).count(99) == 1);
-      EXPECT_TRUE(grid.getValues(i, j).count(99) == 1);
+      grid(i, j).erase(1);
+      ASSERT_TRUE(grid(i, j).count(1) == 0);
+      EXPECT_TRUE(grid.getValues(i, j).count(1) == 0);
     }
   }
 }
@@ -145,9 +162,9 @@ TEST(Grid, getValuesIndex) {
   Grid grid(subrows, subcols);
 
   for (int i = 0; i < grid.size(); i++) {
-    grid[i].emplace(99);
-    ASSERT_TRUE(grid[i].count(99) == 1);
-    EXPECT_TRUE(grid.getValues(i).count(99) == 1);
+    grid[i].erase(1);
+    ASSERT_TRUE(grid[i].count(1) == 0);
+    EXPECT_TRUE(grid.getValues(i).count(1) == 0);
   }
 }
 
@@ -270,4 +287,106 @@ TEST(Grid, assignInvalidOccupied) {
   EXPECT_FALSE(grid.assign(row, col, val));
 }
 
+// Tests rolling back assignments to a trail mark.
+TEST(Grid, rollback) {
+  const int subrows = 2, subcols = 2;
+  const std::vector<int> initGrid = {
+      1, 0,  0, 0,
+      0, 0,  0, 0,
+      0, 0,  0, 0,
+      0, 0,  0, 0,
+  };
+  Grid grid(subrows, subcols, initGrid);
+  const Grid original(grid);
+
+  EXPECT_EQ(grid.getTrailMark(), 0);
+  EXPECT_TRUE(grid.assign(1, 1, 3));
+  EXPECT_GT(grid.getTrailMark(), 0);
+  const int mark = grid.getTrailMark();
+  const Grid assigned(grid);
+  EXPECT_TRUE(grid.assign(0, 1, 2));
+
+  grid.rollback(mark);
+  EXPECT_EQ(grid.getValues(), assigned.getValues());
+  grid.rollback(0);
+  EXPECT_EQ(grid.getValues(), original.getValues());
+  EXPECT_EQ(grid.getTrailMark(), 0);
+}
+
+// Tests rolling back a failed assignment.
+TEST(Grid, rollbackInvalid) {
+  const int subrows = 2, subcols = 2;
+  const std::vector<int> initGrid = {
+      1, 2,  0, 0,
+      0, 0,  0, 0,
+      0, 0,  0, 0,
+      0, 0,  0, 0,
+  };
+  Grid grid(subrows, subcols, initGrid);
+  const Grid original(grid);
+
+  EXPECT_FALSE(grid.assign(0, 2, 4) && grid.assign(0, 3, 4));
+  grid.rollback(0);
+  EXPECT_EQ(grid.getValues(), original.getValues());
+}
+
+// Tests the row, column and box unit tables.
+TEST(Grid, getUnits) {
+  const int subrows = 2, subcols = 3;
+  const Grid grid(subrows, subcols);
+
+  EXPECT_EQ(grid.getNumUnits(), 18);
+  for (int i = 0; i < grid.size(); i++) {
+    EXPECT_THAT(grid.getUnit(grid.getRowUnit(i)), Contains(i));
+    EXPECT_THAT(grid.getUnit(grid.getColUnit(i)), Contains(i));
+    EXPECT_THAT(grid.getUnit(grid.getBoxUnit(i)), Contains(i));
+  }
+  for (int unit = 0; unit < grid.getNumUnits(); ++unit)
+    EXPECT_EQ(grid.getUnit(unit).size(), 6);
+  EXPECT_THAT(grid.getUnit(grid.getBoxUnit(grid.getIndex(3, 4))),
+      ElementsAre(15, 16, 17, 21, 22, 23));
+}
+
+// Tests per-unit value counts follow assignments, rollbacks and edits.
+TEST(Grid, getUnitCount) {
+  const int subrows = 2, subcols = 2;
+  Grid grid(subrows, subcols);
+
+  EXPECT_EQ(grid.getUnitCount(0, 1), 4);
+  EXPECT_TRUE(grid.assign(0, 0, 1));
+  EXPECT_EQ(grid.getUnitCount(grid.getRowUnit(0), 1), 1);
+  EXPECT_EQ(grid.getUnitCount(grid.getRowUnit(0), 2), 3);
+  EXPECT_EQ(grid.getUnitCount(grid.getColUnit(0), 1), 1);
+  EXPECT_EQ(grid.getUnitCount(grid.getBoxUnit(0), 1), 1);
+  EXPECT_EQ(grid.getUnitCount(grid.getRowUnit(15), 1), 3);
+  grid.rollback(0);
+  EXPECT_EQ(grid.getUnitCount(grid.getRowUnit(0), 1), 4);
+
+  grid(3, 3).erase(4);
+  EXPECT_EQ(grid.getUnitCount(grid.getRowUnit(15), 4), 3);
+  EXPECT_EQ(grid.getUnitCount(grid.getBoxUnit(15), 4), 3);
+}
+
+// Tests hidden singles are placed only at that propagation level.
+TEST(Grid, propagateHiddenSingles) {
+  const int subrows = 2, subcols = 2;
+  const std::vector<int> initGrid = {
+      1, 0,  0, 0,
+      0, 0,  0, 0,
+      0, 0,  1, 0,
+      0, 0,  0, 0,
+  };
+  Grid naked(subrows, subcols, initGrid);
+  Grid hidden(naked);
+  hidden.setPropagationLevel(PropagationLevel::HIDDEN_SINGLES);
+
+  EXPECT_TRUE(naked.propagate());
+  EXPECT_EQ(naked.getValues(1, 3).size(), 4);
+  EXPECT_TRUE(hidden.propagate());
+  EXPECT_EQ(hidden.getValues(1, 3).size(), 1);
+  EXPECT_EQ(hidden.getValues(1, 3).count(1), 1);
+  EXPECT_EQ(hidden.getValues(3, 1).size(), 1);
+  EXPECT_EQ(hidden.getValues(3, 1).count(1), 1);
+}
+
 } /* namespace sudoku */
@@ -0,0 +1,95 @@
+/*
+ * mrv_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <random>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/grid.h>
+#include <src/mrv.h>
+
+using std::vector;
+
+namespace sudoku {
+
+// Tests for the minimum remaining values kernels.
+
+TEST(Mrv, findMinKey) {
+  const vector<uint16_t> keys = {9, kMrvSkipKey, 3, 5, 3, kMrvSkipKey, 4};
+  EXPECT_EQ(findMinKey(keys.data(), keys.size()), 2);
+  EXPECT_EQ(findMinKey(keys.data(), 2), 0);
+  EXPECT_EQ(findMinKey(keys.data() + 1, 1), -1);
+  EXPECT_EQ(findMinKey(keys.data(), 0), -1);
+}
+
+// Tests every supported kernel agrees with the scalar one, including ties
+// and lengths that aren't a multiple of the vector width.
+TEST(Mrv, kernelsAgree) {
+  std::mt19937 random(7);
+  for (auto kernel : {MrvKernel::SSE41, MrvKernel::AVX2}) {
+    if (!isSupported(kernel))
+      continue;
+    for (int n = 0; n <= 100; ++n) {
+      for (int trial = 0; trial < 20; ++trial) {
+        vector<uint16_t> keys(n);
+        for (auto& key : keys)
+          key = random() % 3 ? kMrvSkipKey : 2 + random() % 4;
+        EXPECT_EQ(findMinKey(keys.data(), n, kernel),
+            findMinKey(keys.data(), n, MrvKernel::SCALAR));
+      }
+    }
+  }
+}
+
+// Tests the grid's count keys follow assignments, rollbacks and edits.
+TEST(Mrv, gridCountKeys) {
+  Grid grid(2, 2);
+  const int mark = grid.getTrailMark();
+  grid.assign(0, 1);
+  EXPECT_EQ(grid.getCountKeys()[0], kMrvSkipKey);
+  EXPECT_EQ(grid.getCountKeys()[1], 3);
+  EXPECT_EQ(grid.getCountKeys()[6], 4);
+  grid.rollback(mark);
+  EXPECT_EQ(grid.getCountKeys()[0], 4);
+  EXPECT_EQ(grid.getCountKeys()[1], 4);
+
+  grid[6].erase(2);
+  EXPECT_EQ(grid.getCountKeys()[6], 3);
+  EXPECT_EQ(findMinKey(grid.getCountKeys(), grid.size()), 6);
+}
+
+// Tests count buckets select the same cells as the scan through a search.
+TEST(Mrv, countBuckets) {
+  Grid grid(3, 4);
+  grid.setCountBuckets(true);
+  EXPECT_TRUE(grid.hasCountBuckets());
+  std::mt19937 random(11);
+  vector<int> marks;
+  for (int step = 0; step < 200; ++step) {
+    const int index = grid.getMostConstrainedIndex();
+    EXPECT_EQ(index, findMinKey(grid.getCountKeys(), grid.size(),
+        MrvKernel::SCALAR));
+    if (index == -1 || random() % 4 == 0) {
+      if (marks.empty())
+        break;
+      grid.rollback(marks.back());
+      marks.pop_back();
+      continue;
+    }
+    marks.push_back(grid.getTrailMark());
+    grid.assign(index, grid.getValues(index).front());
+  }
+
+  grid[5].clear();
+  EXPECT_EQ(grid.getMostConstrainedIndex(), 5);
+  grid.setCountBuckets(false);
+  EXPECT_EQ(grid.getMostConstrainedIndex(), 5);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,100 @@
+/*
+ * parallel_solver_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/parallel_solver.h>
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace parallelSolverTest {
+
+const int subrows = 3, subcols = 3;
+const std::vector<int> initVec = {
+    0, 0, 0,  0, 0, 0,  0, 0, 0,
+    0, 0, 0,  0, 0, 3,  0, 8, 5,
+    0, 0, 1,  0, 2, 0,  0, 0, 0,
+
+    0, 0, 0,  5, 0, 7,  0, 0, 0,
+    0, 0, 4,  0, 0, 0,  1, 0, 0,
+    0, 9, 0,  0, 0, 0,  0, 0, 0,
+
+    5, 0, 0,  0, 0, 0,  0, 7, 3,
+    0, 0, 2,  0, 1, 0,  0, 0, 0,
+    0, 0, 0,  0, 4, 0,  0, 0, 9,
+};
+const std::vector<int> solutionVec = {
+    9, 8, 7,  6, 5, 4,  3, 2, 1,
+    2, 4, 6,  1, 7, 3,  9, 8, 5,
+    3, 5, 1,  9, 2, 8,  7, 4, 6,
+
+    1, 2, 8,  5, 3, 7,  6, 9, 4,
+    6, 3, 4,  8, 9, 2,  1, 5, 7,
+    7, 9, 5,  4, 6, 1,  8, 3, 2,
+
+    5, 1, 9,  2, 8, 6,  4, 7, 3,
+    4, 7, 2,  3, 1, 9,  5, 6, 8,
+    8, 6, 3,  7, 4, 5,  2, 1, 9,
+};
+
+} /* namespace parallelSolverTest */
+
+// Tests for the ParallelSolver class.
+
+// Tests the solve method.
+TEST(ParallelSolver, solve) {
+  const Grid initGrid(parallelSolverTest::subrows, parallelSolverTest::subcols,
+      parallelSolverTest::initVec);
+  const Grid solutionGrid(parallelSolverTest::subrows,
+      parallelSolverTest::subcols, parallelSolverTest::solutionVec);
+  ParallelSolver solver(initGrid, 4);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getValues(), solutionGrid.getValues());
+  ASSERT_EQ(solver.getThreadSteps().size(), 4);
+  int threadSteps = 0;
+  for (auto& n : solver.getThreadSteps())
+    threadSteps += n;
+  EXPECT_EQ(threadSteps, steps);
+  EXPECT_GE(steps, 1);
+}
+
+TEST(ParallelSolver, solveSingleThread) {
+  const Grid initGrid(parallelSolverTest::subrows, parallelSolverTest::subcols,
+      parallelSolverTest::initVec);
+  ParallelSolver parallel(initGrid, 1);
+  Solver sequential(initGrid);
+  Grid solution, expected;
+  int steps = 0, expectedSteps = 0;
+
+  EXPECT_TRUE(parallel.solve(solution, steps));
+  EXPECT_TRUE(sequential.solve(expected, expectedSteps));
+  EXPECT_EQ(solution.getValues(), expected.getValues());
+  EXPECT_EQ(steps, expectedSteps);
+}
+
+TEST(ParallelSolver, solveNoSolution) {
+  const std::vector<int> initVec = {
+      1, 2,  0, 0,
+      0, 0,  3, 0,
+      0, 0,  0, 3,
+      0, 0,  0, 0,
+  };
+  ParallelSolver solver(Grid(2, 2, initVec), 4);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.solve(solution, steps));
+}
+
+} /* namespace sudoku */
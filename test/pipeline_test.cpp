@@ -0,0 +1,78 @@
+/*
+ * pipeline_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <atomic>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/pipeline.h>
+
+namespace sudoku {
+
+// Tests for the BoundedQueue class.
+
+TEST(BoundedQueue, pushPop) {
+  BoundedQueue<int> queue(2);
+  int item = 0;
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_TRUE(queue.pop(item));
+  EXPECT_EQ(item, 1);
+  queue.close();
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_TRUE(queue.pop(item));
+  EXPECT_EQ(item, 2);
+  EXPECT_FALSE(queue.pop(item));
+}
+
+// Tests for the Pipeline class.
+
+// Tests items are written in input order with bounded items in flight.
+TEST(Pipeline, run) {
+  const int numItems = 1000, capacity = 8;
+  Pipeline<int> pipeline(4, capacity);
+  std::vector<int> written;
+  std::atomic<int> inFlight(0);
+  int maxInFlight = 0;
+  int next = 0;
+
+  long count = pipeline.run([&](int& item) {
+    if (next == numItems)
+      return false;
+    item = next++;
+    maxInFlight = std::max(maxInFlight, ++inFlight);
+    return true;
+  }, [&](int& item) {
+    volatile int spin = (item * 7919) % 1000;
+    while (spin > 0)
+      spin = spin - 1;
+    item *= 2;
+  }, [&](const int& item) {
+    written.push_back(item);
+    --inFlight;
+  });
+
+  EXPECT_EQ(count, numItems);
+  ASSERT_EQ(written.size(), numItems);
+  for (int i = 0; i < numItems; ++i)
+    EXPECT_EQ(written[i], 2 * i);
+  EXPECT_LE(maxInFlight, capacity);
+}
+
+TEST(Pipeline, runEmpty) {
+  Pipeline<int> pipeline(2, 4);
+  int writes = 0;
+
+  EXPECT_EQ(pipeline.run([](int&) { return false; }, [](int&) {},
+      [&](const int&) { writes++; }), 0);
+  EXPECT_EQ(writes, 0);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,71 @@
+/*
+ * portfolio_solver_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/portfolio_solver.h>
+#include <test/solution_check.h>
+
+using testing::Each;
+using testing::Ge;
+
+namespace sudoku {
+
+// Tests for the PortfolioSolver class.
+
+// Tests the default configurations.
+TEST(PortfolioSolver, getDefaultConfigs) {
+  const std::vector<PortfolioConfig> configs =
+      PortfolioSolver::getDefaultConfigs(8, 42);
+
+  ASSERT_EQ(configs.size(), 8u);
+  EXPECT_EQ(toString(configs[0]), "most_constrained/least_constraining/none");
+  EXPECT_EQ(toString(configs[1]),
+      "most_constrained/randomized/luby/seed=42");
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < i; ++j)
+      EXPECT_NE(toString(configs[i]), toString(configs[j]));
+  }
+  EXPECT_EQ(PortfolioSolver::getDefaultConfigs(0).size(), 1u);
+}
+
+// Tests the solve method.
+TEST(PortfolioSolver, solve) {
+  const Grid initGrid(3, 3, solutionCheck::hardVec);
+  const Grid solutionGrid(3, 3, solutionCheck::hardSolutionVec);
+  PortfolioSolver solver(initGrid, PortfolioSolver::getDefaultConfigs(4));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_EQ(solver.getWinner(), -1);
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getValues(), solutionGrid.getValues());
+  ASSERT_GE(solver.getWinner(), 0);
+  ASSERT_LT(solver.getWinner(), 4);
+  EXPECT_EQ(steps, solver.getThreadSteps()[solver.getWinner()]);
+  EXPECT_THAT(solver.getThreadSteps(), Each(Ge(0)));
+}
+
+// Tests the first solver to rule out every move wins on unsolvable grids.
+TEST(PortfolioSolver, solveUnsolvable) {
+  // Any solution would also solve the original grid, whose only solution
+  // has a 1 there.
+  std::vector<int> values(solutionCheck::hardVec);
+  values[1] = 2;
+  PortfolioSolver solver(Grid(3, 3, values),
+      PortfolioSolver::getDefaultConfigs(3));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_GE(solver.getWinner(), 0);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,134 @@
+/*
+ * puzzle_file_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/puzzle_file.h>
+
+using std::string;
+using std::vector;
+
+namespace sudoku {
+
+namespace puzzleFileTest {
+
+string tempPath() {
+  char path[] = "/tmp/puzzle_file_testXXXXXX";
+  const int fd = mkstemp(path);
+  close(fd);
+  return path;
+}
+
+long fileSize(const string& path) {
+  FILE* file = fopen(path.c_str(), "rb");
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+vector<int> makeValues(int numCells, int maxValue, int seed) {
+  vector<int> values(numCells);
+  for (int i = 0; i < numCells; ++i)
+    values[i] = (i * 7 + seed) % (maxValue + 1);
+  return values;
+}
+
+} /* namespace puzzleFileTest */
+
+using namespace puzzleFileTest;
+
+// Tests for the PuzzleFileReader and PuzzleFileWriter classes.
+
+// Tests 9x9 grids round-trip at 4 bits per cell with solutions and stats.
+TEST(PuzzleFile, roundTrip) {
+  const string path = tempPath();
+  const int flags = PuzzleFile::HAS_SOLUTION | PuzzleFile::HAS_STATS;
+  PuzzleFileWriter writer;
+  ASSERT_TRUE(writer.open(path.c_str(), 3, 3, flags));
+  for (int n = 0; n < 3; ++n) {
+    PuzzleRecord record;
+    record.puzzle = makeValues(81, 9, n);
+    if (n != 1)
+      record.solution = makeValues(81, 9, n + 1);
+    record.steps = 1000 + n;
+    record.ns = 5000000000LL + n;
+    record.numSolutions = n != 1;
+    ASSERT_TRUE(writer.write(record));
+  }
+  ASSERT_TRUE(writer.close());
+  EXPECT_EQ(fileSize(path), PuzzleFile::kHeaderSize + 3 * (41 + 41 + 24));
+  EXPECT_TRUE(PuzzleFile::isBinary(path.c_str()));
+
+  PuzzleFileReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  EXPECT_EQ(reader.getSubrows(), 3);
+  EXPECT_EQ(reader.getSubcols(), 3);
+  EXPECT_EQ(reader.getCellBits(), 4);
+  EXPECT_EQ(reader.size(), 3u);
+  PuzzleRecord record;
+  for (int n = 0; n < 3; ++n) {
+    ASSERT_TRUE(reader.read(record));
+    EXPECT_EQ(record.puzzle, makeValues(81, 9, n));
+    EXPECT_EQ(record.solution,
+        n != 1 ? makeValues(81, 9, n + 1) : vector<int>(81));
+    EXPECT_EQ(record.steps, 1000 + n);
+    EXPECT_EQ(record.ns, 5000000000LL + n);
+    EXPECT_EQ(record.numSolutions, n != 1);
+  }
+  EXPECT_FALSE(reader.read(record));
+  unlink(path.c_str());
+}
+
+// Tests random access to records of a 16x16 grid at 8 bits per cell.
+TEST(PuzzleFile, seek) {
+  const string path = tempPath();
+  PuzzleFileWriter writer;
+  ASSERT_TRUE(writer.open(path.c_str(), 4, 4, 0));
+  PuzzleRecord record;
+  for (int n = 0; n < 10; ++n) {
+    record.puzzle = makeValues(256, 16, n);
+    writer.write(record);
+  }
+  ASSERT_TRUE(writer.close());
+
+  PuzzleFileReader reader;
+  ASSERT_TRUE(reader.open(path.c_str()));
+  EXPECT_EQ(reader.getCellBits(), 8);
+  EXPECT_EQ(reader.getRecordSize(), 256);
+  ASSERT_TRUE(reader.seek(7));
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.puzzle, makeValues(256, 16, 7));
+  EXPECT_TRUE(record.solution.empty());
+  ASSERT_TRUE(reader.seek(2));
+  ASSERT_TRUE(reader.read(record));
+  EXPECT_EQ(record.puzzle, makeValues(256, 16, 2));
+  EXPECT_FALSE(reader.seek(11));
+  unlink(path.c_str());
+}
+
+TEST(PuzzleFile, openText) {
+  const string path = tempPath();
+  FILE* file = fopen(path.c_str(), "w");
+  fputs("1 0 0 2 0 0 3 0 0 4 0 0 1 0 0 0\n", file);
+  fclose(file);
+
+  PuzzleFileReader reader;
+  EXPECT_FALSE(PuzzleFile::isBinary(path.c_str()));
+  EXPECT_FALSE(reader.open(path.c_str()));
+  unlink(path.c_str());
+}
+
+} /* namespace sudoku */
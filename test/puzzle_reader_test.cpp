@@ -0,0 +1,134 @@
+/*
+ * puzzle_reader_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/puzzle_reader.h>
+
+using std::string;
+using std::vector;
+using testing::ElementsAre;
+
+namespace sudoku {
+
+namespace puzzleReaderTest {
+
+const char* const kInput =
+    "1 0 0 2\n"
+    "0 0 3 0\n"
+    "+---+---+\n"
+    "|0 4|0 0|\n"
+    "|12 0|0 0|\n"
+    "1.2.0.0.3.4.0.0.0.0.0.0.0.0.1.2\n"
+    "12..3...4.......\r\n"
+    "3004000000000012\n"
+    "5 6";
+
+// Reads every grid of 16 values and the number of values left over.
+vector<vector<int>> readAll(PuzzleReader& reader, int& leftover) {
+  vector<vector<int>> grids;
+  vector<int> values;
+  while ((leftover = reader.read(values, 16)) == 16)
+    grids.push_back(values);
+  return grids;
+}
+
+void expectInput(const vector<vector<int>>& grids, int leftover) {
+  ASSERT_EQ(grids.size(), 4u);
+  EXPECT_THAT(grids[0],
+      ElementsAre(1, 0, 0, 2, 0, 0, 3, 0, 0, 4, 0, 0, 12, 0, 0, 0));
+  EXPECT_THAT(grids[1],
+      ElementsAre(1, 2, 0, 0, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2));
+  EXPECT_THAT(grids[2],
+      ElementsAre(1, 2, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0));
+  EXPECT_THAT(grids[3],
+      ElementsAre(3, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2));
+  EXPECT_EQ(leftover, 2);
+}
+
+} /* namespace puzzleReaderTest */
+
+using namespace puzzleReaderTest;
+
+// Tests for the PuzzleReader class.
+
+// Tests a memory-mapped file in every supported format.
+TEST(PuzzleReader, readFile) {
+  char path[] = "/tmp/puzzle_reader_testXXXXXX";
+  const int fd = mkstemp(path);
+  ASSERT_NE(fd, -1);
+  ASSERT_EQ(write(fd, kInput, strlen(kInput)), (ssize_t) strlen(kInput));
+  close(fd);
+
+  PuzzleReader reader;
+  ASSERT_TRUE(reader.open(path));
+  int leftover;
+  const vector<vector<int>> grids = readAll(reader, leftover);
+  unlink(path);
+
+  expectInput(grids, leftover);
+}
+
+// Tests a pipe read in chunks small enough to split lines and values.
+TEST(PuzzleReader, readPipe) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  std::thread writer([&] {
+    for (const char* c = kInput; *c; ++c)
+      ASSERT_EQ(write(fds[1], c, 1), 1);
+    close(fds[1]);
+  });
+
+  PuzzleReader reader(7);
+  reader.openDescriptor(fds[0]);
+  int leftover;
+  const vector<vector<int>> grids = readAll(reader, leftover);
+  writer.join();
+  close(fds[0]);
+
+  expectInput(grids, leftover);
+}
+
+TEST(PuzzleReader, parseLine) {
+  vector<int> values;
+  const string compact = "12..3...4.......\r";
+  const string spaced = "1 2 0 0 3 0 0 0 4 0 0 0 0 0 0 0";
+  const string dotted = "1.2.0.0.3.4.0.0.0.0.0.0.0.0.1.2";
+
+  EXPECT_EQ(PuzzleReader::parseLine(compact.data(),
+      compact.data() + compact.size(), 16, values), 16);
+  EXPECT_THAT(values,
+      ElementsAre(1, 2, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0));
+  EXPECT_EQ(PuzzleReader::parseLine(spaced.data(),
+      spaced.data() + spaced.size(), 16, values), 16);
+  EXPECT_THAT(values,
+      ElementsAre(1, 2, 0, 0, 3, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0));
+  EXPECT_EQ(PuzzleReader::parseLine(dotted.data(),
+      dotted.data() + dotted.size(), 16, values), 16);
+  EXPECT_THAT(values,
+      ElementsAre(1, 2, 0, 0, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2));
+  EXPECT_EQ(PuzzleReader::parseLine(spaced.data(), spaced.data() + 7, 16,
+      values), 4);
+}
+
+TEST(PuzzleReader, openMissing) {
+  PuzzleReader reader;
+  EXPECT_FALSE(reader.open("/nonexistent/puzzles.txt"));
+  EXPECT_FALSE(reader.isOpen());
+}
+
+} /* namespace sudoku */
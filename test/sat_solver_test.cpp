@@ -0,0 +1,108 @@
+/*
+ * sat_solver_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <chrono>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/sat_solver.h>
+#include <test/solution_check.h>
+
+namespace sudoku {
+
+// Tests for the SatSolver class.
+
+// Tests the solve method.
+TEST(SatSolver, solve) {
+  const Grid initGrid(3, 3, solutionCheck::initVec);
+  const Grid solutionGrid(3, 3, solutionCheck::solutionVec);
+  SatSolver solver(initGrid);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getValues(), solutionGrid.getValues());
+  EXPECT_GE(steps, 1);
+  EXPECT_EQ(solver.getGrid().getValues(), initGrid.getValues());
+}
+
+// Tests a grid that propagation alone can't solve, so the search has to
+// learn from conflicts.
+TEST(SatSolver, solveHard) {
+  const Grid initGrid(3, 3, solutionCheck::hardVec);
+  SatSolver solver(initGrid);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getValues(), Grid(3, 3,
+      solutionCheck::hardSolutionVec).getValues());
+  EXPECT_GT(solver.getNumConflicts(), 0);
+}
+
+TEST(SatSolver, solveNoSolution) {
+  const std::vector<int> initVec = {
+      1, 2,  0, 0,
+      0, 0,  3, 0,
+      0, 0,  0, 3,
+      0, 0,  0, 0,
+  };
+  SatSolver solver(Grid(2, 2, initVec));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::UNSOLVABLE);
+}
+
+TEST(SatSolver, solveEmptyLarge) {
+  SatSolver solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_TRUE(solutionCheck::isSolved(solution));
+}
+
+TEST(SatSolver, solveRectangular) {
+  SatSolver solver(Grid(2, 3));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solution.getNumRows(), 6);
+  EXPECT_TRUE(solutionCheck::isSolved(solution));
+}
+
+// Tests a node limit and a passed deadline both abort.
+TEST(SatSolver, setLimits) {
+  SatSolver solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  SolveLimits limits;
+  limits.maxNodes = 1;
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 1);
+
+  limits = SolveLimits();
+  limits.deadline = std::chrono::steady_clock::now();
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 0);
+
+  solver.setLimits(SolveLimits());
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+}
+
+} /* namespace sudoku */
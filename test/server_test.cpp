@@ -0,0 +1,138 @@
+/*
+ * server_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/server.h>
+
+using std::string;
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace serverTest {
+
+string toUpper(const string& request) {
+  string response(request);
+  for (auto& c : response)
+    c = toupper(c);
+  return response;
+}
+
+// Writes input to a pipe, serves it, and returns what was written back.
+string serveAll(Server& server, const string& input) {
+  int in[2], out[2];
+  if (pipe(in) != 0 || pipe(out) != 0)
+    return "";
+  EXPECT_EQ(write(in[1], input.data(), input.size()), (ssize_t) input.size());
+  close(in[1]);
+  EXPECT_TRUE(server.serve(in[0], out[1]));
+  close(in[0]);
+  close(out[1]);
+
+  string output;
+  char buffer[256];
+  for (ssize_t n; (n = read(out[0], buffer, sizeof(buffer))) > 0; )
+    output.append(buffer, n);
+  close(out[0]);
+  return output;
+}
+
+} /* namespace serverTest */
+
+// Tests for the Server class.
+
+// Tests blank lines are skipped and a last line without a newline is still
+// answered.
+TEST(Server, serve) {
+  Server server(serverTest::toUpper, 1);
+
+  EXPECT_EQ(serverTest::serveAll(server, "abc\n\n  \r\nd e\nf"),
+      "ABC\nD E\nF\n");
+}
+
+// Tests a batch is spread over the pool, with responses still in order.
+TEST(Server, serveBatch) {
+  std::mutex mutex;
+  std::vector<std::thread::id> threads(4);
+  Server server([&](const string& request) {
+    const int i = request[0] - '0';
+    std::this_thread::sleep_for(std::chrono::milliseconds(10 * (4 - i)));
+    std::lock_guard<std::mutex> lock(mutex);
+    threads[i] = std::this_thread::get_id();
+    return request + "!";
+  }, 4);
+
+  EXPECT_EQ(server.getNumThreads(), 4);
+  EXPECT_EQ(serverTest::serveAll(server, "0\n1\n2\n3\n"), "0!\n1!\n2!\n3!\n");
+  EXPECT_EQ(threads[0], std::this_thread::get_id());
+  for (int i = 1; i < 4; ++i)
+    EXPECT_NE(threads[i], std::this_thread::get_id());
+}
+
+TEST(Server, listen) {
+  const string path = "/tmp/sudoku_server_test_" + std::to_string(getpid())
+      + ".sock";
+  Server server(serverTest::toUpper, 2);
+  bool listened = false;
+  std::thread listener([&] { listened = server.listen(path); });
+
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path.c_str());
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  bool connected = false;
+  for (int i = 0; i < 500 && !connected; ++i) {
+    connected = connect(fd, reinterpret_cast<sockaddr*>(&address),
+        sizeof(address)) == 0;
+    if (!connected)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(connected);
+
+  const string request = "one\ntwo\n";
+  EXPECT_EQ(write(fd, request.data(), request.size()),
+      (ssize_t) request.size());
+  string response;
+  char buffer[256];
+  while (response.size() < 8) {
+    const ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n <= 0)
+      break;
+    response.append(buffer, n);
+  }
+  EXPECT_EQ(response, "ONE\nTWO\n");
+
+  // Stopping ends the open connection as well as the listener.
+  server.stop();
+  listener.join();
+  EXPECT_EQ(read(fd, buffer, sizeof(buffer)), 0);
+  close(fd);
+  EXPECT_TRUE(listened);
+  EXPECT_NE(access(path.c_str(), F_OK), 0);
+}
+
+TEST(Server, listenBadPath) {
+  Server server(serverTest::toUpper, 1);
+  EXPECT_FALSE(server.listen("/nonexistent/dir/sudoku.sock"));
+}
+
+} /* namespace sudoku */
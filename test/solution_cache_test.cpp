@@ -0,0 +1,151 @@
+/*
+ * solution_cache_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/canonicalizer.h>
+#include <src/solution_cache.h>
+#include <test/solution_check.h>
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace solutionCacheTest {
+
+// Swaps the first two bands and transposes, then swaps values 1 and 9.
+GridTransform makeTransform() {
+  GridTransform transform;
+  transform.side = 9;
+  transform.transposed = true;
+  for (int i = 0; i < 9; ++i) {
+    transform.rows.push_back(i < 6 ? (i + 3) % 6 : i);
+    transform.cols.push_back(i);
+    transform.labels.push_back(i);
+  }
+  transform.labels.push_back(9);
+  transform.labels[1] = 9;
+  transform.labels[9] = 1;
+  return transform;
+}
+
+} /* namespace solutionCacheTest */
+
+// Tests for the SolutionCache class.
+
+// Tests an equivalent puzzle hits the cache and gets its own solution.
+TEST(SolutionCache, solve) {
+  SolutionCache cache(4);
+  Solver solver(Grid(3, 3, solutionCheck::initVec));
+  Grid solution;
+  int steps = 0;
+  SolveStats stats;
+
+  EXPECT_EQ(cache.solve(solver, solution, steps, &stats),
+      SolveStatus::SOLVED);
+  EXPECT_GT(steps, 0);
+  EXPECT_EQ(solution.getValues(),
+      Grid(3, 3, solutionCheck::solutionVec).getValues());
+
+  const GridTransform transform = solutionCacheTest::makeTransform();
+  Solver other(Grid(3, 3, transform.apply(solutionCheck::initVec)));
+  EXPECT_EQ(cache.solve(other, solution, steps, &stats),
+      SolveStatus::SOLVED);
+  EXPECT_EQ(steps, 0);
+  EXPECT_EQ(solution.getValues(), Grid(3, 3,
+      transform.apply(solutionCheck::solutionVec)).getValues());
+
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 1);
+  EXPECT_GT(cache.getCanonicalizationNs(), 0);
+  if (SolveStats::kEnabled) {
+    EXPECT_EQ(stats.cacheHits, 1);
+    EXPECT_EQ(stats.cacheMisses, 1);
+    EXPECT_EQ(stats.canonicalizationNs, cache.getCanonicalizationNs());
+  }
+}
+
+TEST(SolutionCache, solveNoSolution) {
+  std::vector<int> initVec(solutionCheck::initVec);
+  initVec[1] = 5;
+  SolutionCache cache(4);
+  int calls = 0;
+  auto solve = [&](const Grid& grid, Grid& solution, int& steps) {
+    calls++;
+    Solver solver(grid);
+    solver.solve(solution, steps);
+    return solver.getStatus();
+  };
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_EQ(cache.solve(Grid(3, 3, initVec), solution, steps, solve),
+      SolveStatus::UNSOLVABLE);
+  EXPECT_EQ(cache.solve(Grid(3, 3, initVec), solution, steps, solve),
+      SolveStatus::UNSOLVABLE);
+  EXPECT_EQ(calls, 1);
+}
+
+// Tests aborted solves are retried rather than cached as unsolvable.
+TEST(SolutionCache, solveAborted) {
+  SolutionCache cache(4);
+  Solver solver(Grid(3, 3, solutionCheck::initVec));
+  SolveLimits limits;
+  limits.maxNodes = 1;
+  solver.setLimits(limits);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_EQ(cache.solve(solver, solution, steps), SolveStatus::ABORTED);
+  EXPECT_EQ(cache.size(), 0);
+  solver.setLimits(SolveLimits());
+  EXPECT_EQ(cache.solve(solver, solution, steps), SolveStatus::SOLVED);
+  EXPECT_EQ(cache.getMisses(), 2);
+}
+
+// Tests grids propagation already filled aren't looked up.
+TEST(SolutionCache, solveFilled) {
+  SolutionCache cache(4);
+  Solver solver(Grid(3, 3, solutionCheck::solutionVec));
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_EQ(cache.solve(solver, solution, steps), SolveStatus::SOLVED);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.getMisses(), 0);
+}
+
+// Tests the least recently used result is evicted.
+TEST(SolutionCache, evict) {
+  std::vector<int> otherVec(solutionCheck::initVec);
+  otherVec[0] = 1;
+  const Grid grid(3, 3, solutionCheck::initVec), other(3, 3, otherVec);
+  SolutionCache cache(1);
+  int calls = 0;
+  auto solve = [&](const Grid& grid, Grid& solution, int& steps) {
+    calls++;
+    Solver solver(grid);
+    solver.solve(solution, steps);
+    return solver.getStatus();
+  };
+  Grid solution;
+  int steps = 0;
+
+  cache.solve(grid, solution, steps, solve);
+  cache.solve(other, solution, steps, solve);
+  cache.solve(other, solution, steps, solve);
+  EXPECT_EQ(calls, 2);
+  cache.solve(grid, solution, steps, solve);
+  EXPECT_EQ(calls, 3);
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(cache.getCapacity(), 1);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,94 @@
+/*
+ * solution_check.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#ifndef SOLUTION_CHECK_H_
+#define SOLUTION_CHECK_H_
+
+#include <vector>
+
+#include <src/grid.h>
+
+namespace sudoku {
+
+// Test puzzles and helper functions shared by the solver tests.
+namespace solutionCheck {
+
+// A puzzle that takes some search, and its solution.
+const std::vector<int> initVec = {
+    0, 0, 5,  3, 0, 0,  0, 0, 0,
+    8, 0, 0,  0, 0, 0,  0, 2, 0,
+    0, 7, 0,  0, 1, 0,  5, 0, 0,
+
+    4, 0, 0,  0, 0, 5,  3, 0, 0,
+    0, 1, 0,  0, 7, 0,  0, 0, 6,
+    0, 0, 3,  2, 0, 0,  0, 8, 0,
+
+    0, 6, 0,  5, 0, 0,  0, 0, 9,
+    0, 0, 4,  0, 0, 0,  0, 3, 0,
+    0, 0, 0,  0, 0, 9,  7, 0, 0,
+};
+const std::vector<int> solutionVec = {
+    1, 4, 5,  3, 2, 7,  6, 9, 8,
+    8, 3, 9,  6, 5, 4,  1, 2, 7,
+    6, 7, 2,  9, 1, 8,  5, 4, 3,
+
+    4, 9, 6,  1, 8, 5,  3, 7, 2,
+    2, 1, 8,  4, 7, 3,  9, 5, 6,
+    7, 5, 3,  2, 9, 6,  4, 8, 1,
+
+    3, 6, 7,  5, 4, 2,  8, 1, 9,
+    9, 8, 4,  7, 6, 1,  2, 3, 5,
+    5, 2, 1,  8, 3, 9,  7, 6, 4,
+};
+
+// Arto Inkala's "hardest" puzzle, which takes much more search, and its
+// solution.
+const std::vector<int> hardVec = {
+    8, 0, 0,  0, 0, 0,  0, 0, 0,
+    0, 0, 3,  6, 0, 0,  0, 0, 0,
+    0, 7, 0,  0, 9, 0,  2, 0, 0,
+
+    0, 5, 0,  0, 0, 7,  0, 0, 0,
+    0, 0, 0,  0, 4, 5,  7, 0, 0,
+    0, 0, 0,  1, 0, 0,  0, 3, 0,
+
+    0, 0, 1,  0, 0, 0,  0, 6, 8,
+    0, 0, 8,  5, 0, 0,  0, 1, 0,
+    0, 9, 0,  0, 0, 0,  4, 0, 0,
+};
+const std::vector<int> hardSolutionVec = {
+    8, 1, 2,  7, 5, 3,  6, 4, 9,
+    9, 4, 3,  6, 8, 2,  1, 7, 5,
+    6, 7, 5,  4, 9, 1,  2, 8, 3,
+
+    1, 5, 4,  2, 3, 7,  8, 9, 6,
+    3, 6, 9,  8, 4, 5,  7, 2, 1,
+    2, 8, 7,  1, 6, 9,  5, 3, 4,
+
+    5, 2, 1,  9, 7, 4,  3, 6, 8,
+    4, 3, 8,  5, 2, 6,  9, 1, 7,
+    7, 9, 6,  3, 1, 8,  4, 5, 2,
+};
+
+// Checks every unit of a solved grid holds each value exactly once, for
+// grids (such as empty ones) with no single expected solution.
+inline bool isSolved(const Grid& grid) {
+  for (int unit = 0; unit < grid.getNumUnits(); ++unit) {
+    std::vector<int> seen(grid.getMaxValue() + 1);
+    for (auto i : grid.getUnit(unit)) {
+      if (grid.getValues(i).size() != 1 || seen[grid.getValues(i).front()]++)
+        return false;
+    }
+  }
+  return true;
+}
+
+} /* namespace solutionCheck */
+
+} /* namespace sudoku */
+
+#endif /* SOLUTION_CHECK_H_ */
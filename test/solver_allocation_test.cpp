@@ -0,0 +1,157 @@
+/*
+ * solver_allocation_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/solver.h>
+#include <test/solution_check.h>
+
+// Counts the current thread's heap allocations while counting is on. The
+// replacements apply to the whole test binary, but only count inside the
+// regions the tests below mark.
+namespace {
+
+thread_local bool countingAllocations = false;
+thread_local long long numAllocations = 0;
+
+} /* namespace */
+
+void* operator new(std::size_t size) {
+  if (countingAllocations)
+    numAllocations++;
+  if (void* p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace solverAllocationTest {
+
+// Solves twice with the solver, returning the allocations made by each
+// solve, and fails unless both solved.
+std::vector<long long> countSolveAllocations(Solver& solver) {
+  Grid solution(solver.getGrid().getSubrows(), solver.getGrid().getSubcols());
+  std::vector<long long> counts;
+  counts.reserve(2);
+  for (int i = 0; i < 2; ++i) {
+    int steps = 0;
+    numAllocations = 0;
+    countingAllocations = true;
+    const bool solved = solver.solve(solution, steps);
+    countingAllocations = false;
+    EXPECT_TRUE(solved);
+    counts.push_back(numAllocations);
+  }
+  return counts;
+}
+
+} /* namespace solverAllocationTest */
+
+// Tests for the Solver class's memory use.
+
+// Tests the counting itself.
+TEST(SolverAllocation, counts) {
+  numAllocations = 0;
+  countingAllocations = true;
+  // A call rather than a new expression, which may be optimized out.
+  void* p = ::operator new(sizeof(int));
+  countingAllocations = false;
+  ::operator delete(p);
+
+  EXPECT_EQ(numAllocations, 1);
+
+  numAllocations = 0;
+  countingAllocations = true;
+  std::vector<int> values(1);
+  countingAllocations = false;
+
+  EXPECT_EQ(numAllocations, 1);
+}
+
+TEST(SolverAllocation, solve) {
+  for (auto level : { PropagationLevel::NAKED_SINGLES,
+      PropagationLevel::HIDDEN_SINGLES, PropagationLevel::LOCKED_CANDIDATES,
+      PropagationLevel::PAIRS }) {
+    Solver solver(Grid(3, 3, solutionCheck::hardVec),
+        VariableSortType::MOST_CONSTRAINED,
+        ValueSortType::LEAST_CONSTRAINING, level);
+
+    EXPECT_THAT(solverAllocationTest::countSolveAllocations(solver),
+        testing::Each(0)) << "level " << (int) level;
+  }
+}
+
+TEST(SolverAllocation, solveRandomizedRestarts) {
+  Solver solver(Grid(3, 3, solutionCheck::hardVec),
+      VariableSortType::RANDOMIZED, ValueSortType::RANDOMIZED);
+  solver.setRestartPolicy(RestartPolicy::LUBY, 10);
+
+  EXPECT_THAT(solverAllocationTest::countSolveAllocations(solver),
+      testing::Each(0));
+}
+
+TEST(SolverAllocation, solveLarge) {
+  Solver solver(Grid(4, 4), VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING, PropagationLevel::HIDDEN_SINGLES);
+
+  EXPECT_THAT(solverAllocationTest::countSolveAllocations(solver),
+      testing::Each(0));
+}
+
+// Tests a solver reused for another grid of the same dimensions, with more
+// blanks, doesn't allocate again.
+TEST(SolverAllocation, setGrid) {
+  std::vector<int> otherVec(solutionCheck::hardVec);
+  otherVec[0] = 0;
+  const Grid grid(3, 3, solutionCheck::hardVec), other(3, 3, otherVec);
+  Solver solver(grid);
+  Grid solution(3, 3);
+  int steps = 0;
+  solver.setGrid(grid);
+  ASSERT_TRUE(solver.solve(solution, steps));
+
+  numAllocations = 0;
+  countingAllocations = true;
+  solver.setGrid(other);
+  const bool solved = solver.solve(solution, steps);
+  countingAllocations = false;
+
+  EXPECT_TRUE(solved);
+  EXPECT_EQ(numAllocations, 0);
+}
+
+TEST(SolverAllocation, countSolutions) {
+  std::vector<int> initVec(solutionCheck::hardVec);
+  initVec[0] = 0;
+  Solver solver(Grid(3, 3, initVec));
+  int steps = 0;
+
+  numAllocations = 0;
+  countingAllocations = true;
+  const int count = solver.countSolutions(steps);
+  countingAllocations = false;
+
+  EXPECT_GE(count, 1);
+  EXPECT_EQ(numAllocations, 0);
+}
+
+} /* namespace sudoku */
@@ -0,0 +1,128 @@
+/*
+ * solver_pool_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Vance Zuo
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <src/solver_pool.h>
+#include <test/solution_check.h>
+
+using std::vector;
+
+namespace sudoku {
+
+// Test helper constants/functions.
+namespace solverPoolTest {
+
+// The shared puzzle with one clue changed to each of 1-9 in turn, so some grids
+// have no solution.
+vector<Grid> makeGrids() {
+  vector<Grid> grids;
+  for (int value = 1; value <= 9; ++value) {
+    vector<int> values(solutionCheck::initVec);
+    values[1] = value;
+    grids.emplace_back(3, 3, values);
+  }
+  return grids;
+}
+
+} /* namespace solverPoolTest */
+
+// Tests for the SolverPool class.
+
+TEST(SolverPool, submit) {
+  SolverPool pool(2);
+  const Grid grid(3, 3, solutionCheck::initVec);
+  Grid expected;
+  int steps = 0;
+  ASSERT_TRUE(Solver(grid).solve(expected, steps));
+
+  SolverPool::Result result = pool.submit(grid).get();
+  EXPECT_EQ(pool.getNumThreads(), 2);
+  EXPECT_EQ(result.status, SolveStatus::SOLVED);
+  EXPECT_EQ(result.solution.getValues(), expected.getValues());
+  EXPECT_EQ(result.steps, steps);
+  EXPECT_GT(result.ns, 0);
+}
+
+// Tests batch results match solving each grid alone, in order, and the
+// callback sees each grid once, with the result its future gets.
+TEST(SolverPool, submitBatch) {
+  const vector<Grid> grids = solverPoolTest::makeGrids();
+  SolverPool pool(3);
+  std::mutex mutex;
+  vector<int> calls(grids.size());
+  vector<SolverPool::Result> callbackResults(grids.size());
+
+  auto futures = pool.submitBatch(grids,
+      [&](int index, const SolverPool::Result& result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    calls[index]++;
+    callbackResults[index] = result;
+  });
+  ASSERT_EQ(futures.size(), grids.size());
+  int numSolved = 0;
+  for (int i = 0; i < (signed) grids.size(); ++i) {
+    const SolverPool::Result result = futures[i].get();
+    Grid expected;
+    int steps = 0;
+    const bool solved = Solver(grids[i]).solve(expected, steps);
+    EXPECT_EQ(result.status,
+        solved ? SolveStatus::SOLVED : SolveStatus::UNSOLVABLE) << i;
+    EXPECT_EQ(result.steps, steps) << i;
+    EXPECT_EQ(callbackResults[i].status, result.status) << i;
+    EXPECT_EQ(callbackResults[i].steps, result.steps) << i;
+    if (solved) {
+      EXPECT_EQ(result.solution.getValues(), expected.getValues()) << i;
+    }
+    numSolved += solved;
+  }
+  EXPECT_GT(numSolved, 0);
+  EXPECT_LT(numSolved, (signed) grids.size());
+  EXPECT_THAT(calls, testing::Each(1));
+  EXPECT_TRUE(pool.submitBatch(nullptr, 0).empty());
+}
+
+TEST(SolverPool, limits) {
+  SolveLimits limits;
+  limits.maxNodes = 1;
+  SolverPool pool(1, PropagationLevel::NAKED_SINGLES, limits);
+
+  const SolverPool::Result result = pool.submit(Grid(4, 4)).get();
+  EXPECT_EQ(result.status, SolveStatus::ABORTED);
+  EXPECT_EQ(result.steps, 1);
+}
+
+// Tests destroying the pool finishes the grids already submitted.
+TEST(SolverPool, destructor) {
+  const vector<Grid> grids = solverPoolTest::makeGrids();
+  std::atomic<int> calls(0);
+  vector<std::future<SolverPool::Result>> futures;
+  {
+    SolverPool pool(2);
+    for (int i = 0; i < 4; ++i) {
+      auto batch = pool.submitBatch(grids,
+          [&](int, const SolverPool::Result&) { calls++; });
+      for (auto& future : batch)
+        futures.push_back(std::move(future));
+    }
+  }
+
+  EXPECT_EQ(calls, 4 * (signed) grids.size());
+  for (auto& future : futures) {
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(0)),
+        std::future_status::ready);
+  }
+}
+
+} /* namespace sudoku */
@@ -5,6 +5,10 @@
  *      Author: Vance Zuo
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -16,7 +20,6 @@ using testing::Contains;
 using testing::ContainerEq;
 
 using std::vector;
-using std::unordered_set;
 
 namespace sudoku {
 
@@ -54,8 +57,9 @@ const std::vector<int> solutionVec = {
 const Grid initGrid(subrows, subcols, initVec);
 const Grid solutionGrid(subrows, subcols, solutionVec);
 
-Solver init(VariableSortType varSortType, ValueSortType valSortType) {
-  return Solver(initGrid, varSortType, valSortType);
+Solver init(VariableSortType varSortType, ValueSortType valSortType,
+    PropagationLevel level = PropagationLevel::NAKED_SINGLES) {
+  return Solver(initGrid, varSortType, valSortType, level);
 }
 
 } /* namespace solverTest */
@@ -104,4 +108,259 @@ TEST(Solver, solveOpt) {
   EXPECT_GE(steps, 1);
 }
 
+// Tests solving leaves the solver's grid untouched.
+TEST(Solver, solveKeepsGrid) {
+  Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING);
+  Grid solution;
+  int steps = 0, again = 0;
+
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getGrid().getValues(), solverTest::initGrid.getValues());
+  EXPECT_TRUE(solver.solve(solution, again));
+  EXPECT_EQ(steps, again);
+  EXPECT_EQ(solution.getTrailMark(), 0);
+}
+
+TEST(Solver, solvePropagationLevels) {
+  int nakedSteps = 0;
+  for (auto level : { PropagationLevel::NAKED_SINGLES,
+      PropagationLevel::HIDDEN_SINGLES, PropagationLevel::LOCKED_CANDIDATES,
+      PropagationLevel::PAIRS }) {
+    Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+        ValueSortType::LEAST_CONSTRAINING, level);
+    Grid solution;
+    int steps = 0;
+
+    EXPECT_TRUE(solver.solve(solution, steps));
+    EXPECT_EQ(solution.getValues(), solverTest::solutionGrid.getValues());
+    if (level == PropagationLevel::NAKED_SINGLES)
+      nakedSteps = steps;
+    EXPECT_LE(steps, nakedSteps);
+  }
+}
+
+// Tests the solveAll method.
+TEST(Solver, solveAll) {
+  Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING);
+  vector<Grid> solutions;
+  vector<int> steps;
+
+  EXPECT_EQ(solver.solveAll(solutions, steps), 1);
+  ASSERT_EQ(solutions.size(), 1);
+  ASSERT_EQ(steps.size(), 1);
+  EXPECT_EQ(solutions[0].getValues(), solverTest::solutionGrid.getValues());
+  EXPECT_GE(steps[0], 1);
+}
+
+TEST(Solver, solveAllLimit) {
+  Solver solver(Grid(2, 2));
+  vector<Grid> solutions;
+  vector<int> steps;
+
+  EXPECT_EQ(solver.solveAll(solutions, steps, 5), 5);
+  EXPECT_EQ(solutions.size(), 5);
+  for (unsigned int i = 1; i < solutions.size(); ++i) {
+    EXPECT_NE(solutions[i].getValues(), solutions[i - 1].getValues());
+    EXPECT_GE(steps[i], steps[i - 1]);
+  }
+}
+
+TEST(Solver, solveAllVisitor) {
+  Solver solver(Grid(2, 2));
+  int visited = 0, steps = 0;
+
+  EXPECT_EQ(solver.solveAll([&](const Grid&) { return ++visited < 3; },
+      steps), 3);
+  EXPECT_EQ(visited, 3);
+}
+
+// Tests the countSolutions method.
+TEST(Solver, countSolutions) {
+  Solver solver(Grid(2, 2));
+  int steps = 0;
+
+  EXPECT_EQ(solver.countSolutions(steps), 288);
+  EXPECT_EQ(solver.countSolutions(steps, 2), 2);
+}
+
+// Tests the hasUniqueSolution method.
+TEST(Solver, hasUniqueSolution) {
+  Solver unique = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING);
+  Solver multiple(Grid(3, 3));
+
+  EXPECT_TRUE(unique.hasUniqueSolution());
+  EXPECT_FALSE(multiple.hasUniqueSolution());
+}
+
+// Tests the search stats against the step count they mirror.
+TEST(Solver, getStats) {
+  if (!SolveStats::kEnabled)
+    return;
+  Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING);
+  Grid solution;
+  int steps = 0;
+
+  EXPECT_FALSE(solver.isCollectingStats());
+  ASSERT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStats().assignments, 0);
+
+  solver.setCollectStats(true);
+  ASSERT_TRUE(solver.solve(solution, steps));
+  const SolveStats& stats = solver.getStats();
+  EXPECT_EQ(stats.assignments, steps);
+  EXPECT_LT(stats.backtracks, stats.assignments);
+  EXPECT_LE(stats.deadEnds, stats.backtracks);
+  EXPECT_GE(stats.propagations, solution.size() - 21);
+  EXPECT_GE(stats.eliminations, stats.propagations);
+  ASSERT_EQ((signed) stats.depthNodes.size(), stats.maxDepth + 1);
+  EXPECT_EQ(stats.depthNodes[0], 1);
+  long long nodes = 0;
+  for (auto& count : stats.depthNodes)
+    nodes += count;
+  EXPECT_EQ(nodes, stats.assignments - stats.deadEnds + 1);
+
+  int countSteps = 0;
+  EXPECT_EQ(solver.countSolutions(countSteps), 1);
+  EXPECT_EQ(solver.getStats().assignments, countSteps);
+}
+
+// Tests solves with the same seed repeat, and other seeds take other paths.
+TEST(Solver, setSeed) {
+  Solver solver = solverTest::init(VariableSortType::RANDOMIZED,
+      ValueSortType::RANDOMIZED);
+  Grid solution;
+  int steps = 0, repeatSteps = 0;
+  vector<int> seedSteps;
+
+  EXPECT_EQ(solver.getSeed(), Solver::kDefaultSeed);
+  for (uint64_t seed = 1; seed <= 5; ++seed) {
+    solver.setSeed(seed);
+    ASSERT_TRUE(solver.solve(solution, steps));
+    ASSERT_TRUE(solver.solve(solution, repeatSteps));
+    EXPECT_EQ(steps, repeatSteps);
+    EXPECT_EQ(solution.getValues(), solverTest::solutionGrid.getValues());
+    seedSteps.push_back(steps);
+  }
+  EXPECT_THAT(seedSteps, Contains(Ne(seedSteps.front())));
+}
+
+// Tests the start of the Luby and geometric budget sequences.
+TEST(Solver, getRestartBudget) {
+  const vector<long long> luby = {1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8};
+  for (int run = 0; run < (signed) luby.size(); ++run) {
+    EXPECT_EQ(Solver::getRestartBudget(RestartPolicy::LUBY, 10, run),
+        10 * luby[run]);
+  }
+  EXPECT_EQ(Solver::getRestartBudget(RestartPolicy::GEOMETRIC, 100, 0), 100);
+  EXPECT_EQ(Solver::getRestartBudget(RestartPolicy::GEOMETRIC, 100, 2), 225);
+  EXPECT_EQ(Solver::getRestartBudget(RestartPolicy::NONE, 100, 5), 0);
+}
+
+// Tests restarting searches still find every solution, once.
+TEST(Solver, setRestartPolicy) {
+  for (auto policy : {RestartPolicy::LUBY, RestartPolicy::GEOMETRIC}) {
+    Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+        ValueSortType::RANDOMIZED);
+    solver.setRestartPolicy(policy, 1);
+    Grid solution;
+    int steps = 0;
+
+    EXPECT_EQ(solver.getRestartPolicy(), policy);
+    EXPECT_TRUE(solver.solve(solution, steps));
+    EXPECT_EQ(solution.getValues(), solverTest::solutionGrid.getValues());
+    if (SolveStats::kEnabled) {
+      solver.setCollectStats(true);
+      EXPECT_TRUE(solver.solve(solution, steps));
+      EXPECT_GE(solver.getStats().restarts, 1);
+    }
+
+    Solver empty(Grid(2, 2), VariableSortType::RANDOMIZED,
+        ValueSortType::RANDOMIZED);
+    empty.setRestartPolicy(policy, 1);
+    vector<Grid> solutions;
+    vector<int> solutionSteps;
+    EXPECT_EQ(empty.solveAll(solutions, solutionSteps), 288);
+    vector<vector<int>> values;
+    for (auto& grid : solutions) {
+      values.emplace_back();
+      for (auto& cell : grid.getValues())
+        values.back().push_back(cell.front());
+    }
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(std::unique(values.begin(), values.end()), values.end());
+  }
+}
+
+// Tests the status of finished solves.
+TEST(Solver, getStatus) {
+  Solver solver = solverTest::init(VariableSortType::MOST_CONSTRAINED,
+      ValueSortType::LEAST_CONSTRAINING);
+  vector<int> conflictVec(solverTest::initVec);
+  conflictVec[1] = 5;
+  Solver conflict(Grid(3, 3, conflictVec));
+  Grid solution;
+  int steps = 0;
+
+  ASSERT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+  EXPECT_FALSE(conflict.solve(solution, steps));
+  EXPECT_EQ(conflict.getStatus(), SolveStatus::UNSOLVABLE);
+}
+
+// Tests solves stop at exactly the node limit, and searches that fit in it
+// aren't affected.
+TEST(Solver, setLimitsMaxNodes) {
+  Solver solver(Grid(2, 2), VariableSortType::NONE, ValueSortType::NONE);
+  Grid solution;
+  int steps = 0, fullSteps = 0;
+  ASSERT_EQ(solver.countSolutions(fullSteps), 288);
+
+  SolveLimits limits;
+  limits.maxNodes = fullSteps / 2;
+  solver.setLimits(limits);
+  solver.setCollectStats(true);
+  const int numSolutions = solver.countSolutions(steps);
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, limits.maxNodes);
+  EXPECT_GT(numSolutions, 0);
+  EXPECT_LT(numSolutions, 288);
+  if (SolveStats::kEnabled) {
+    EXPECT_EQ(solver.getStats().assignments, steps);
+  }
+
+  limits.maxNodes = fullSteps;
+  solver.setLimits(limits);
+  EXPECT_EQ(solver.countSolutions(steps), 288);
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+}
+
+// Tests a passed deadline and a set cancellation token both abort.
+TEST(Solver, setLimitsDeadlineCancel) {
+  Solver solver(Grid(4, 4));
+  Grid solution;
+  int steps = 0;
+
+  SolveLimits limits;
+  limits.deadline = std::chrono::steady_clock::now();
+  solver.setLimits(limits);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+  EXPECT_EQ(steps, 0);
+
+  std::atomic<bool> cancel(true);
+  solver.setLimits(SolveLimits());
+  solver.setCancelFlag(&cancel);
+  EXPECT_EQ(solver.getLimits().cancel, &cancel);
+  EXPECT_FALSE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::ABORTED);
+
+  cancel = false;
+  EXPECT_TRUE(solver.solve(solution, steps));
+  EXPECT_EQ(solver.getStatus(), SolveStatus::SOLVED);
+}
+
 } /* namespace sudoku */